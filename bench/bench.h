@@ -0,0 +1,99 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// --- Mikrobenchmark harness ---
+// Svaki benchmark: BENCH_WARMUP neizmerenih ponavljanja, pa `reps` merenih.
+// Jedno ponavljanje = setup (ne meri se) + fn(ctx, iters); uzorak je ns po
+// operaciji. Ispisuje se tabela (median, p99, min), a bench_finish pise JSON
+// sa svim uzorcima (za poredjenje sa baseline-om). Broj ponavljanja se moze
+// menjati promenljivom okruzenja BENCH_REPS.
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_WARMUP 3
+#define BENCH_MAX_RESULTS 64
+#define BENCH_MAX_REPS 1000
+
+typedef struct {
+    char name[64];
+    int64_t iters;
+    int reps;
+    double median, p99, min, mean;   // ns/op
+    double* samples;
+} BenchResult;
+
+typedef void (*BenchFn)(void* ctx, int64_t iters);
+
+static BenchResult bench_results[BENCH_MAX_RESULTS];
+static int bench_result_count = 0;
+static int bench_default_reps = 30;
+// Sprecava da kompajler izbaci racunanje ciji se rezultat ne koristi
+static volatile uint64_t bench_sink;
+
+static double bench_now_ns() { struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return t.tv_sec * 1e9 + t.tv_nsec; }
+static int bench_cmp_double(const void* a, const void* b) { double x = *(const double*)a, y = *(const double*)b; return (x > y) - (x < y); }
+
+static void bench_init() {
+    const char* env = getenv("BENCH_REPS");
+    if (env != NULL && atoi(env) > 0) bench_default_reps = atoi(env) < BENCH_MAX_REPS ? atoi(env) : BENCH_MAX_REPS;
+    printf("%-36s %10s %12s %12s %12s\n", "benchmark", "iters", "median ns", "p99 ns", "min ns");
+}
+
+// reps <= 0 znaci podrazumevani broj ponavljanja
+static const BenchResult* bench_run(const char* name, BenchFn setup, BenchFn fn, void* ctx, int64_t iters, int reps) {
+    if (bench_result_count == BENCH_MAX_RESULTS) return NULL;
+    if (reps <= 0) reps = bench_default_reps;
+    BenchResult* r = &bench_results[bench_result_count++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->iters = iters; r->reps = reps;
+    r->samples = malloc((size_t)reps * sizeof(double));
+    for (int i = -BENCH_WARMUP; i < reps; i++) {
+        if (setup != NULL) setup(ctx, iters);
+        double t0 = bench_now_ns();
+        fn(ctx, iters);
+        double ns = (bench_now_ns() - t0) / (double)iters;
+        if (i >= 0) r->samples[i] = ns;
+    }
+    double* sorted = malloc((size_t)reps * sizeof(double));
+    memcpy(sorted, r->samples, (size_t)reps * sizeof(double));
+    qsort(sorted, (size_t)reps, sizeof(double), bench_cmp_double);
+    r->min = sorted[0];
+    r->median = (reps % 2) ? sorted[reps / 2] : 0.5 * (sorted[reps / 2 - 1] + sorted[reps / 2]);
+    int p99 = (int)(0.99 * (reps - 1) + 0.5);
+    r->p99 = sorted[p99];
+    r->mean = 0.0;
+    for (int i = 0; i < reps; i++) r->mean += sorted[i] / reps;
+    free(sorted);
+    printf("%-36s %10lld %12.1f %12.1f %12.1f\n", r->name, (long long)iters, r->median, r->p99, r->min);
+    fflush(stdout);
+    return r;
+}
+
+static int bench_finish(const char* suite, const char* json_path) {
+    int ok = 1;
+    if (json_path != NULL) {
+        FILE* f = fopen(json_path, "w");
+        if (f == NULL) { perror(json_path); ok = 0; }
+        else {
+            fprintf(f, "{\"suite\":\"%s\",\"unit\":\"ns/op\",\"results\":[", suite);
+            for (int i = 0; i < bench_result_count; i++) {
+                const BenchResult* r = &bench_results[i];
+                fprintf(f, "%s\n{\"name\":\"%s\",\"iters\":%lld,\"reps\":%d,\"median\":%.3f,\"p99\":%.3f,\"min\":%.3f,\"mean\":%.3f,\"samples\":[",
+                        i ? "," : "", r->name, (long long)r->iters, r->reps, r->median, r->p99, r->min, r->mean);
+                for (int k = 0; k < r->reps; k++) fprintf(f, "%s%.3f", k ? "," : "", r->samples[k]);
+                fprintf(f, "]}");
+            }
+            fprintf(f, "\n]}\n");
+            ok = fclose(f) == 0;
+        }
+    }
+    for (int i = 0; i < bench_result_count; i++) free(bench_results[i].samples);
+    bench_result_count = 0;
+    return ok;
+}
+
+#endif
@@ -0,0 +1,221 @@
+// Kapija za regresije performansi: poredi rezultate benchmark-a (JSON iz
+// bench.h) sa baseline-om za ovu masinu i pada ako je nesto znacajno sporije.
+//
+//   bench_gate [-d bench/baselines] [-p profil] [-a alfa] [-t prag_%] [--update] rezultati.json...
+//
+// Baseline je bench/baselines/<profil>/<suite>.json; profil je podrazumevano
+// <os>-<arhitektura>-<broj jezgara>c (ili BENCH_PROFILE), jer poredjenje
+// brojeva sa razlicitih masina nema smisla. --update upisuje nove rezultate kao baseline.
+//
+// Za svaki benchmark: jednostrani Mann-Whitney U test (da li su novi uzorci
+// stohasticki veci) uz normalnu aproksimaciju sa korekcijom za vezane rangove.
+// Regresija je samo kad je p < alfa I medijana porasla vise od praga (10%):
+// ponavljanja unutar jednog pokretanja su medjusobno slicnija nego dva
+// pokretanja, pa sam test na bucnoj masini javlja i pomake od par procenata.
+// Baseline zato treba praviti na mirnoj masini, istim build-om.
+// Izlaz: 0 bez regresija, 1 regresija, 2 greska ili nema baseline-a.
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#define GATE_MAX_BENCH 64
+#define GATE_PATH_MAX 512
+
+typedef struct { char name[64]; int n; double* samples; double median; } GateBench;
+typedef struct { char suite[64]; int count; GateBench bench[GATE_MAX_BENCH]; } GateSuite;
+typedef struct { double v; int from_new; } RankItem;
+
+static char* read_file(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* data = len >= 0 ? malloc((size_t)len + 1) : NULL;
+    if (data != NULL && fread(data, 1, (size_t)len, f) != (size_t)len) { free(data); data = NULL; }
+    if (data != NULL) data[len] = '\0';
+    fclose(f);
+    return data;
+}
+
+// Pokazivac na vrednost iza "key": (razmaci dozvoljeni), ili NULL
+static const char* json_key(const char* p, const char* key) {
+    char pattern[32];
+    snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+    while ((p = strstr(p, pattern)) != NULL) {
+        p += strlen(pattern);
+        while (*p == ' ' || *p == '\n' || *p == '\t' || *p == '\r') p++;
+        if (*p != ':') continue;
+        for (p++; *p == ' ' || *p == '\n' || *p == '\t' || *p == '\r'; p++) {}
+        return p;
+    }
+    return NULL;
+}
+
+// "key":"vrednost" -> out; vraca pokazivac iza vrednosti ili NULL
+static const char* json_string(const char* p, const char* key, char* out, size_t cap) {
+    p = json_key(p, key);
+    if (p == NULL || *p != '"') return NULL;
+    size_t n = 0;
+    for (p++; *p && *p != '"'; p++) if (n + 1 < cap) out[n++] = *p;
+    out[n] = '\0';
+    return *p ? p + 1 : NULL;
+}
+
+static int cmp_double(const void* a, const void* b) { double x = *(const double*)a, y = *(const double*)b; return (x > y) - (x < y); }
+static int cmp_rank(const void* a, const void* b) { return cmp_double(&((const RankItem*)a)->v, &((const RankItem*)b)->v); }
+
+static double median_of(const double* v, int n) {
+    double* s = malloc((size_t)n * sizeof(double));
+    if (s == NULL || n == 0) { free(s); return 0.0; }
+    memcpy(s, v, (size_t)n * sizeof(double));
+    qsort(s, (size_t)n, sizeof(double), cmp_double);
+    double m = (n % 2) ? s[n / 2] : 0.5 * (s[n / 2 - 1] + s[n / 2]);
+    free(s);
+    return m;
+}
+
+// Cita samo format koji pise bench_finish: suite, pa redom name ... samples:[...]
+static int load_suite(const char* path, GateSuite* s) {
+    memset(s, 0, sizeof(*s));
+    char* data = read_file(path);
+    if (data == NULL) return 0;
+    const char* p = json_string(data, "suite", s->suite, sizeof(s->suite));
+    while (p != NULL && s->count < GATE_MAX_BENCH) {
+        GateBench* b = &s->bench[s->count];
+        if ((p = json_string(p, "name", b->name, sizeof(b->name))) == NULL) break;
+        const char* q = json_key(p, "samples");
+        if (q == NULL || *q++ != '[') break;
+        int cap = 64;
+        b->samples = malloc((size_t)cap * sizeof(double));
+        while (b->samples != NULL && *q != ']' && *q != '\0') {
+            char* end;
+            double v = strtod(q, &end);
+            if (end == q) break;
+            if (b->n == cap) { cap *= 2; double* grown = realloc(b->samples, (size_t)cap * sizeof(double)); if (grown == NULL) break; b->samples = grown; }
+            b->samples[b->n++] = v;
+            for (q = end; *q == ',' || *q == ' ' || *q == '\n'; q++) {}
+        }
+        b->median = median_of(b->samples, b->n);
+        s->count++;
+        p = q;
+    }
+    free(data);
+    return s->suite[0] != '\0';
+}
+
+static void free_suite(GateSuite* s) { for (int i = 0; i < s->count; i++) free(s->bench[i].samples); s->count = 0; }
+
+static const GateBench* find_bench(const GateSuite* s, const char* name) {
+    for (int i = 0; i < s->count; i++) if (strcmp(s->bench[i].name, name) == 0) return &s->bench[i];
+    return NULL;
+}
+
+// Jednostrani p za hipotezu "novi uzorci su veci od baseline-a"
+static double mann_whitney_greater(const GateBench* base, const GateBench* cur) {
+    int n1 = base->n, n2 = cur->n, n = n1 + n2;
+    if (n1 < 2 || n2 < 2) return 1.0;
+    RankItem* items = malloc((size_t)n * sizeof(RankItem));
+    if (items == NULL) return 1.0;
+    for (int i = 0; i < n1; i++) items[i] = (RankItem){ base->samples[i], 0 };
+    for (int i = 0; i < n2; i++) items[n1 + i] = (RankItem){ cur->samples[i], 1 };
+    qsort(items, (size_t)n, sizeof(RankItem), cmp_rank);
+    double rank_sum = 0.0, ties = 0.0;
+    for (int i = 0; i < n;) {
+        int j = i;
+        while (j + 1 < n && items[j + 1].v == items[i].v) j++;
+        double rank = 0.5 * (i + j) + 1.0, t = j - i + 1;   // prosecan rang grupe jednakih
+        for (int k = i; k <= j; k++) if (items[k].from_new) rank_sum += rank;
+        ties += t * t * t - t;
+        i = j + 1;
+    }
+    free(items);
+    double u = rank_sum - n2 * (n2 + 1) / 2.0, mean = n1 * (double)n2 / 2.0;
+    double var = n1 * (double)n2 / 12.0 * ((n + 1) - ties / ((double)n * (n - 1)));
+    if (var <= 0.0) return 1.0;
+    double z = (u - mean - 0.5) / sqrt(var);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+static void default_profile(char* out, size_t cap) {
+    const char* env = getenv("BENCH_PROFILE");
+    if (env != NULL && env[0]) { snprintf(out, cap, "%s", env); return; }
+    struct utsname u;
+    if (uname(&u) != 0) { snprintf(out, cap, "default"); return; }
+    snprintf(out, cap, "%.32s-%.32s-%ldc", u.sysname, u.machine, sysconf(_SC_NPROCESSORS_ONLN));
+    for (char* c = out; *c; c++) if (*c >= 'A' && *c <= 'Z') *c = (char)(*c - 'A' + 'a'); else if (*c == '/' || *c == ' ') *c = '_';
+}
+
+static int copy_file(const char* from, const char* to) {
+    char* data = read_file(from);
+    if (data == NULL) return 0;
+    FILE* f = fopen(to, "wb");
+    int ok = f != NULL && fputs(data, f) >= 0;
+    if (f != NULL && fclose(f) != 0) ok = 0;
+    free(data);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    const char* dir = "bench/baselines";
+    char profile[128] = "";
+    double alpha = 0.01, threshold = 10.0;
+    int update = 0, first_file = argc;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--update") == 0) update = 1;
+        else if (a + 1 < argc && strcmp(argv[a], "-d") == 0) dir = argv[++a];
+        else if (a + 1 < argc && strcmp(argv[a], "-p") == 0) snprintf(profile, sizeof(profile), "%s", argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "-a") == 0) alpha = atof(argv[++a]);
+        else if (a + 1 < argc && strcmp(argv[a], "-t") == 0) threshold = atof(argv[++a]);
+        else { first_file = a; break; }
+    }
+    if (first_file >= argc) { fprintf(stderr, "Upotreba: bench_gate [-d dir] [-p profil] [-a alfa] [-t prag_%%] [--update] rezultati.json...\n"); return 2; }
+    if (profile[0] == '\0') default_profile(profile, sizeof(profile));
+
+    char profile_dir[GATE_PATH_MAX], path[GATE_PATH_MAX + 80];   // + ime suite-a
+    snprintf(profile_dir, sizeof(profile_dir), "%s/%s", dir, profile);
+    int regressions = 0, errors = 0;
+    for (int f = first_file; f < argc; f++) {
+        GateSuite cur, base;
+        if (!load_suite(argv[f], &cur)) { fprintf(stderr, "Ne mogu da procitam %s\n", argv[f]); errors++; continue; }
+        snprintf(path, sizeof(path), "%s/%s.json", profile_dir, cur.suite);
+
+        if (update) {
+            if ((mkdir(dir, 0755) != 0 && errno != EEXIST) || (mkdir(profile_dir, 0755) != 0 && errno != EEXIST) || !copy_file(argv[f], path)) { perror(path); errors++; }
+            else printf("Baseline %s: %d benchmark-a -> %s\n", cur.suite, cur.count, path);
+            free_suite(&cur);
+            continue;
+        }
+        if (!load_suite(path, &base)) {
+            fprintf(stderr, "Nema baseline-a %s (profil %s); napravi ga sa --update (make bench-baseline)\n", path, profile);
+            free_suite(&cur); errors++; continue;
+        }
+
+        printf("Suite %s, profil %s (alfa %.3g, prag %.1f%%)\n", cur.suite, profile, alpha, threshold);
+        printf("%-36s %12s %12s %9s %9s  %s\n", "benchmark", "base ns", "novo ns", "delta", "p", "status");
+        for (int i = 0; i < cur.count; i++) {
+            const GateBench* c = &cur.bench[i];
+            const GateBench* b = find_bench(&base, c->name);
+            if (b == NULL) { printf("%-36s %12s %12.1f %9s %9s  NOVO\n", c->name, "-", c->median, "-", "-"); continue; }
+            double delta = b->median > 0.0 ? (c->median / b->median - 1.0) * 100.0 : 0.0;
+            double p_slower = mann_whitney_greater(b, c);
+            double p_faster = mann_whitney_greater(c, b);
+            const char* status = "ok";
+            if (p_slower < alpha && delta > threshold) { status = "SPORIJE"; regressions++; }
+            else if (p_faster < alpha && delta < -threshold) status = "brze";
+            printf("%-36s %12.1f %12.1f %+8.1f%% %9.4f  %s\n", c->name, b->median, c->median, delta, delta >= 0.0 ? p_slower : p_faster, status);
+        }
+        for (int i = 0; i < base.count; i++) if (find_bench(&cur, base.bench[i].name) == NULL) printf("%-36s %12.1f %12s %9s %9s  NEDOSTAJE\n", base.bench[i].name, base.bench[i].median, "-", "-", "-");
+        free_suite(&cur);
+        free_suite(&base);
+    }
+    if (update) return errors ? 2 : 0;
+    if (regressions) { printf("Regresija: %d benchmark-a znacajno sporije\n", regressions); return 1; }
+    return errors ? 2 : 0;
+}
@@ -0,0 +1,76 @@
+// Benchmark parsiranja tekstualnog leaderboard-a: generise fajl sa N linija
+// (podrazumevano 10M) i meri mmap + brzi parser naspram fgets + sscanf + mktime.
+//   ./bench_parse [broj_linija] [putanja] [--no-baseline]
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "leaderboard_text.h"
+
+static double now_ms() { struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return t.tv_sec * 1e3 + t.tv_nsec / 1e6; }
+
+static int generate(const char* path, long lines) {
+    FILE* f = fopen(path, "w"); if (f == NULL) return 0;
+    setvbuf(f, NULL, _IOFBF, 1 << 20);
+    time_t t = 1700000000;
+    srand(42);
+    for (long i = 0; i < lines; i++) {
+        t += rand() % 600;
+        struct tm tm_info; localtime_r(&t, &tm_info);
+        char ts[30]; strftime(ts, sizeof(ts), "%Y-%m-%d %H:%M:%S", &tm_info);
+        fprintf(f, "%d %s\n", rand() % 5000, ts);
+    }
+    return fclose(f) == 0;
+}
+
+// Stari put (migracija pre brzog parsera), kao referenca i provera rezultata
+static long parse_baseline(const char* path, int64_t* checksum) {
+    FILE* f = fopen(path, "r"); if (f == NULL) return -1;
+    char line[128]; long n = 0; *checksum = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int s; struct tm tm_info = {0};
+        if (sscanf(line, "%d %d-%d-%d %d:%d:%d", &s, &tm_info.tm_year, &tm_info.tm_mon, &tm_info.tm_mday, &tm_info.tm_hour, &tm_info.tm_min, &tm_info.tm_sec) != 7) continue;
+        tm_info.tm_year -= 1900; tm_info.tm_mon -= 1; tm_info.tm_isdst = -1;
+        *checksum += s + (int64_t)mktime(&tm_info);
+        n++;
+    }
+    fclose(f);
+    return n;
+}
+
+int main(int argc, char** argv) {
+    long lines = 10000000;
+    const char* path = "/tmp/bench_leaderboard.txt";
+    int baseline = 1;
+    for (int i = 1, pos = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--no-baseline") == 0) baseline = 0;
+        else if (pos++ == 0) lines = atol(argv[i]);
+        else path = argv[i];
+    }
+    double t0 = now_ms();
+    if (!generate(path, lines)) { fprintf(stderr, "Ne mogu da napravim %s\n", path); return 1; }
+    printf("Generisano %ld linija u %s (%.0f ms)\n", lines, path, now_ms() - t0);
+
+    LeaderboardEntry* entries; size_t skipped;
+    t0 = now_ms();
+    long n = leaderboard_read_text_file(path, &entries, &skipped);
+    double fast = now_ms() - t0;
+    if (n < 0) { fprintf(stderr, "Ne mogu da procitam %s\n", path); return 1; }
+    int64_t sum = 0;
+    for (long i = 0; i < n; i++) sum += entries[i].score + entries[i].epoch_time;
+    free(entries);
+    printf("mmap parser:   %ld zapisa, %zu preskoceno, %8.1f ms, %6.1f M linija/s\n", n, skipped, fast, n / fast / 1e3);
+
+    if (baseline) {
+        int64_t ref_sum;
+        t0 = now_ms();
+        long ref = parse_baseline(path, &ref_sum);
+        double slow = now_ms() - t0;
+        printf("fgets+sscanf:  %ld zapisa, %8.1f ms, %6.1f M linija/s (%.1fx)\n", ref, slow, ref / slow / 1e3, slow / fast);
+        if (ref != n || ref_sum != sum) { fprintf(stderr, "Rezultati se razlikuju od reference!\n"); return 1; }
+    }
+    remove(path);
+    return 0;
+}
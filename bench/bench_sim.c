@@ -0,0 +1,276 @@
+// Mikrobenchmark-i vrucih putanja simulacije i leaderboard-a (bez GLFW/GL).
+//   bench_sim [-o rezultati.json]
+// Velicina bazena dolazi iz game.h; `make bench` pravi i verziju sa
+// -DMAX_ASTEROIDS/-DMAX_BULLETS za velike brojeve entiteta.
+#include "bench.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bot.h"
+#include "game.h"
+#include "leaderboard.h"
+#include "pixel_obs.h"
+#include "render.h"
+#include "replay.h"
+#include "rl_env.h"
+
+#define STEP_DT (1.0 / 240.0)
+#define UPDATE_STEPS 32   // koraka po ponavljanju; stanje se vraca pre svakog
+
+typedef struct { GameState* live; GameState* prepared; } SimCtx;
+
+static GameState live_state, prepared_state;
+
+// n asteroida u gornjoj polovini i 2n metaka ispod njih; igrac daleko, pravilo promasaja iskljuceno
+static void prepare(GameState* g, int asteroids, int bullets, int moving) {
+    initialize_game(g, 12345);
+    g->missed_asteroids_rule_enabled = 0;
+    g->player.position = g->player.prev_position = (Vec2){0.0f, -0.95f};
+    for (int i = 0; i < asteroids && i < MAX_ASTEROIDS; i++) {
+        spawn_asteroid(g);
+        g->asteroids[i].position = g->asteroids[i].prev_position = (Vec2){ -0.95f + 1.9f * (float)(i % 32) / 31.0f, 0.2f + 0.8f * (float)(i / 32) / (float)(asteroids / 32 + 1) };
+    }
+    for (int i = 0; i < bullets && i < MAX_BULLETS; i++) {
+        shoot_bullet(g);
+        g->bullets[i].position = g->bullets[i].prev_position = (Vec2){ -0.97f + 1.94f * (float)(i % 64) / 63.0f, -0.7f + 0.6f * (float)(i / 64) / (float)(bullets / 64 + 1) };
+        if (!moving) g->bullets[i].velocity.y = 0.0f;
+    }
+    g->asteroid_spawn_timer = -1e9;   // bez novih asteroida tokom merenja
+}
+
+static void restore(void* ctx, int64_t iters) { (void)iters; SimCtx* c = ctx; memcpy(c->live, c->prepared, sizeof(GameState)); }
+
+static void run_update(void* ctx, int64_t iters) {
+    SimCtx* c = ctx;
+    for (int64_t i = 0; i < iters; i++) update_state(c->live, STEP_DT);
+    bench_sink += (uint64_t)c->live->score;
+}
+
+static void run_collisions(void* ctx, int64_t iters) {
+    SimCtx* c = ctx;
+    for (int64_t i = 0; i < iters; i++) resolve_bullet_hits(c->live);
+    bench_sink += c->live->collision_stats.pairs;
+}
+
+// Predaja za crtanje: pakovanje cele scene u instance (sve sto frejm radi pre glBufferData)
+static Arena render_arena;
+static void run_snapshot(void* ctx, int64_t iters) {
+    SimCtx* c = ctx;
+    for (int64_t i = 0; i < iters; i++) {
+        arena_reset(&render_arena);
+        RenderSnapshot s;
+        render_snapshot_build(&s, c->live, &render_arena);
+        bench_sink += (uint64_t)s.quads.count;
+    }
+}
+
+// Opservacija 84x84 u sivoj i RGB (sa zvezdama) iz istog stanja
+static uint8_t pixel_buffer[84 * 84 * 3];
+static void run_pixels_gray(void* ctx, int64_t iters) { for (int64_t i = 0; i < iters; i++) pixel_obs_render(((SimCtx*)ctx)->live, pixel_buffer, 84, 84, 0); bench_sink += pixel_buffer[0]; }
+static void run_pixels_rgb(void* ctx, int64_t iters) { for (int64_t i = 0; i < iters; i++) pixel_obs_render(((SimCtx*)ctx)->live, pixel_buffer, 84, 84, PIXEL_OBS_RGB | PIXEL_OBS_STARS); bench_sink += pixel_buffer[0]; }
+
+// Jedna odluka autopilota (nivo expert misli svakog koraka)
+static void run_bot(void* ctx, int64_t iters) {
+    SimCtx* c = ctx;
+    Bot bot;
+    bot_init(&bot, BOT_EXPERT, 1);
+    GameInput in;
+    for (int64_t i = 0; i < iters; i++) { bot.think_timer = 0.0; bot_think(&bot, c->live, STEP_DT, &in); bench_sink += (uint64_t)in.left + (uint64_t)in.shoot; }
+}
+
+// Igra koju vodi autopilot od pocetka: realan niz ulaza i rast tezine do minimalnog razmaka stvaranja
+static void run_bot_game(void* ctx, int64_t iters) {
+    SimCtx* c = ctx;
+    Bot bot;
+    bot_init(&bot, BOT_NORMAL, c->live->seed);
+    GameInput in;
+    for (int64_t i = 0; i < iters; i++) {
+        bot_think(&bot, c->live, STEP_DT, &in);
+        apply_input(c->live, &in, STEP_DT);
+        update_state(c->live, STEP_DT);
+    }
+    bench_sink += (uint64_t)c->live->score;
+}
+
+// Jedan korak vektorizovanog okruzenja (sve igre, opservacije i nagrade) na jednoj niti
+#define RL_BENCH_ENVS 256
+static int32_t rl_actions[RL_BENCH_ENVS];
+static float rl_obs[RL_BENCH_ENVS * RL_OBS_SIZE], rl_reward[RL_BENCH_ENVS];
+static uint8_t rl_done[RL_BENCH_ENVS];
+static void reset_rl(void* ctx, int64_t iters) { (void)iters; rl_env_reset(ctx, 99, rl_obs); }
+static void run_rl_step(void* ctx, int64_t iters) {
+    for (int64_t i = 0; i < iters; i++) {
+        for (int e = 0; e < RL_BENCH_ENVS; e++) rl_actions[e] = (int32_t)((i + e) % RL_ACTION_COUNT);
+        rl_env_step(ctx, rl_actions, rl_obs, rl_reward, rl_done);
+    }
+    bench_sink += (uint64_t)rl_done[0];
+}
+
+static void run_hsv(void* ctx, int64_t iters) {
+    (void)ctx;
+    float acc = 0.0f;
+    for (int64_t i = 0; i < iters; i++) { Vec3 c = hsv_to_rgb((float)(i & 1023) * (1.0f / 1024.0f), 0.9f, 0.95f); acc += c.r + c.g + c.b; }
+    bench_sink += (uint64_t)acc;
+}
+
+// Prazan bazen: svaki novi objekat se odmah oslobadja, pa je slot uvek nadjen
+static void run_spawn_empty(void* ctx, int64_t iters) {
+    GameState* g = ((SimCtx*)ctx)->live;
+    for (int64_t i = 0; i < iters; i++) { spawn_asteroid(g); bitset_clear_all(g->asteroid_live, ASTEROID_WORDS); }
+}
+static void run_shoot_empty(void* ctx, int64_t iters) {
+    GameState* g = ((SimCtx*)ctx)->live;
+    for (int64_t i = 0; i < iters; i++) { shoot_bullet(g); bitset_clear_all(g->bullet_live, BULLET_WORDS); }
+}
+// Pun bazen: samo trazenje slobodnog slota koje ne uspeva
+static void fill_pools(void* ctx, int64_t iters) {
+    (void)iters; GameState* g = ((SimCtx*)ctx)->live;
+    for (int i = 0; i < MAX_ASTEROIDS; i++) bitset_set(g->asteroid_live, i);
+    for (int i = 0; i < MAX_BULLETS; i++) bitset_set(g->bullet_live, i);
+}
+static void run_spawn_full(void* ctx, int64_t iters) { GameState* g = ((SimCtx*)ctx)->live; for (int64_t i = 0; i < iters; i++) spawn_asteroid(g); }
+static void run_shoot_full(void* ctx, int64_t iters) { GameState* g = ((SimCtx*)ctx)->live; for (int64_t i = 0; i < iters; i++) shoot_bullet(g); }
+static void clear_pools(void* ctx, int64_t iters) {
+    (void)iters; GameState* g = ((SimCtx*)ctx)->live;
+    bitset_clear_all(g->asteroid_live, ASTEROID_WORDS); bitset_clear_all(g->bullet_live, BULLET_WORDS);
+}
+
+// --- Snimak: skok na proizvoljan korak (kljucni frejm + premotavanje) ---
+static Replay bench_replay;
+static void run_replay_seek(void* ctx, int64_t iters) {
+    GameState* g = ((SimCtx*)ctx)->live;
+    for (int64_t i = 0; i < iters; i++) replay_seek(&bench_replay, g, (uint32_t)((uint64_t)(i + 1) * 2654435761u % (bench_replay.tick_count + 1)));
+    bench_sink += (uint64_t)g->score;
+}
+
+static void bench_replay_seek(SimCtx* ctx) {
+    char path[] = "/tmp/sb_replay.XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) { fprintf(stderr, "Nema privremenog fajla, snimak preskocen\n"); return; }
+    close(fd);
+    // 60 s igre autopilota, kljucni frejm na svakih REPLAY_KEYFRAME_INTERVAL koraka
+    GameState* g = ctx->live;
+    initialize_game(g, 777);
+    g->missed_asteroids_rule_enabled = 1;
+    Bot bot;
+    bot_init(&bot, BOT_NORMAL, g->seed);
+    ReplayWriter w;
+    if (replay_writer_open(&w, path, g, 0)) {
+        for (int i = 0; i < (int)(60.0 / STEP_DT) && !g->game_over; i++) {
+            GameInput in;
+            bot_think(&bot, g, STEP_DT, &in);
+            replay_writer_tick(&w, g, &in, STEP_DT);
+            apply_input(g, &in, STEP_DT);
+            update_state(g, STEP_DT);
+        }
+        if (replay_writer_close(&w) && replay_open(&bench_replay, path)) {
+            bench_run("replay_seek/60s", NULL, run_replay_seek, ctx, 16, 0);
+            replay_close(&bench_replay);
+        }
+    }
+    remove(path);
+}
+
+// --- Leaderboard (u privremenom direktorijumu) ---
+static int score_counter = 0;
+static void run_add_score(void* ctx, int64_t iters) {
+    (void)ctx;
+    for (int64_t i = 0; i < iters; i++) add_score_to_leaderboard((score_counter++ * 7919) % 5000, 12.5f);
+}
+// I/O nit mora da isprazni red pre sledeceg ponavljanja
+static void drain_pause(void* ctx, int64_t iters) { (void)ctx; (void)iters; struct timespec d = { 0, 60000000L }; nanosleep(&d, NULL); }
+static void run_load(void* ctx, int64_t iters) { (void)ctx; for (int64_t i = 0; i < iters; i++) load_leaderboard(); bench_sink += (uint64_t)leaderboard_count; }
+
+static void fill_journal(void* ctx, int64_t iters) { (void)ctx; (void)iters; for (int i = 0; i < 64; i++) add_score_to_leaderboard(i * 37 % 5000, 1.0f); }
+static void run_compact(void* ctx, int64_t iters) { (void)ctx; (void)iters; leaderboard_compact(); }
+static void remove_leaderboard_files() {
+    const char* files[] = { LEADERBOARD_BIN, LEADERBOARD_BIN ".tmp", LEADERBOARD_JOURNAL, LEADERBOARD_SKETCH, "history.txt" };
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) remove(files[i]);
+    char run[64];
+    for (int i = 1; i < LEADERBOARD_RUNS; i++) {
+        snprintf(run, sizeof(run), "%s.%d", LEADERBOARD_BIN, i); remove(run);
+        snprintf(run, sizeof(run), "%s.%d.tmp", LEADERBOARD_BIN, i); remove(run);
+    }
+}
+
+static void bench_leaderboard() {
+    char cwd[512], dir[] = "/tmp/sb_bench.XXXXXX";
+    if (getcwd(cwd, sizeof(cwd)) == NULL || mkdtemp(dir) == NULL || chdir(dir) != 0) { fprintf(stderr, "Nema privremenog direktorijuma, leaderboard preskocen\n"); return; }
+
+    load_leaderboard();
+    // Sinhroni put (bez I/O niti): write + fsync zurnala i snimanje sketch-a po pozivu
+    bench_run("add_score/sync", NULL, run_add_score, NULL, 8, 10);
+    // Asinhroni put kakav koristi igra: frejm nit samo azurira memoriju i stavlja u red
+    leaderboard_io_start();
+    bench_run("add_score/async", drain_pause, run_add_score, NULL, 256, 15);
+    leaderboard_io_stop();
+
+    // Istorija od 100k igara u snimku + rep zurnala
+    FILE* f = fopen("history.txt", "w");
+    for (int i = 0; f != NULL && i < 100000; i++) fprintf(f, "%d 2024-05-%02d 12:%02d:%02d\n", (i * 7919) % 5000, 1 + i % 28, i % 60, (i / 60) % 60);
+    if (f != NULL) fclose(f);
+    load_leaderboard();
+    leaderboard_import_text("history.txt");
+    for (int i = 0; i < 300; i++) add_score_to_leaderboard(i, 1.0f);
+    bench_run("load_leaderboard/100k+300", NULL, run_load, NULL, 1, 20);
+    // Kompakcija repa od 64 igre nad istorijom od 100k: upisuje se rep, ne cela istorija
+    bench_run("leaderboard_compact/100k+64", fill_journal, run_compact, NULL, 1, 20);
+
+    remove_leaderboard_files();
+    if (chdir(cwd) != 0) perror(cwd);
+    rmdir(dir);
+}
+
+int main(int argc, char** argv) {
+    const char* json = NULL;
+    for (int i = 1; i + 1 < argc; i++) if (strcmp(argv[i], "-o") == 0) json = argv[i + 1];
+    char suite[64];
+    snprintf(suite, sizeof(suite), "sim-a%d-b%d", MAX_ASTEROIDS, MAX_BULLETS);
+    printf("Suite %s\n", suite);
+    bench_init();
+
+    SimCtx ctx = { &live_state, &prepared_state };
+    if (!arena_init(&render_arena, FRAME_ARENA_SIZE)) { fprintf(stderr, "Nema memorije za arenu\n"); return 1; }
+    char name[64];
+    // update_state i sudari pri cetvrtini, polovini i punom bazenu
+    for (int fill = 1; fill <= 4; fill *= 2) {
+        int n = MAX_ASTEROIDS * fill / 4, nb = MAX_BULLETS * fill / 4;
+        prepare(&prepared_state, n, nb, 1);
+        snprintf(name, sizeof(name), "update_state/a%d-b%d", n, nb);
+        bench_run(name, restore, run_update, &ctx, UPDATE_STEPS, 0);
+        // Metci miruju ispod asteroida: svi parovi prolaze kroz grubu fazu, nijedan pogodak
+        prepare(&prepared_state, n, nb, 0);
+        snprintf(name, sizeof(name), "collisions/a%d-b%d", n, nb);
+        bench_run(name, restore, run_collisions, &ctx, 16, 0);
+        snprintf(name, sizeof(name), "render_snapshot/a%d-b%d", n, nb);
+        bench_run(name, restore, run_snapshot, &ctx, 16, 0);
+        snprintf(name, sizeof(name), "pixel_obs_gray/a%d-b%d", n, nb);
+        bench_run(name, restore, run_pixels_gray, &ctx, 16, 0);
+        snprintf(name, sizeof(name), "pixel_obs_rgb/a%d-b%d", n, nb);
+        bench_run(name, restore, run_pixels_rgb, &ctx, 16, 0);
+        snprintf(name, sizeof(name), "bot_think/a%d-b%d", n, nb);
+        bench_run(name, restore, run_bot, &ctx, 16, 0);
+    }
+
+    initialize_game(&prepared_state, 777);
+    prepared_state.missed_asteroids_rule_enabled = 1;
+    bench_run("bot_game/60s", restore, run_bot_game, &ctx, (int64_t)(60.0 / STEP_DT), 10);
+
+    RlEnv* rl = rl_env_create(RL_BENCH_ENVS, 1, 1);
+    if (rl != NULL) { bench_run("rl_env_step/256", reset_rl, run_rl_step, rl, 60, 10); rl_env_destroy(rl); }
+
+    bench_replay_seek(&ctx);
+
+    bench_run("hsv_to_rgb", NULL, run_hsv, NULL, 1 << 16, 0);
+
+    prepare(&prepared_state, 0, 0, 1);
+    restore(&ctx, 0);
+    bench_run("spawn_asteroid/empty", clear_pools, run_spawn_empty, &ctx, 4096, 0);
+    bench_run("shoot_bullet/empty", clear_pools, run_shoot_empty, &ctx, 4096, 0);
+    bench_run("spawn_asteroid/full", fill_pools, run_spawn_full, &ctx, 4096, 0);
+    bench_run("shoot_bullet/full", fill_pools, run_shoot_full, &ctx, 4096, 0);
+
+    bench_leaderboard();
+    return bench_finish(suite, json) ? 0 : 1;
+}
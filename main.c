@@ -5,188 +5,226 @@
 #include <time.h>
 #include <math.h>
 #include <string.h>
-
-// --- Definicije ---
-#define MAX_ASTEROIDS 50
-#define MAX_BULLETS 100
-#define MAX_STARS 300
-#define NUM_LAYERS 3
-#define MISSED_ASTEROID_LIMIT 10
-#define LEADERBOARD_SIZE 100
+#include <stddef.h>
+#include "arena.h"
+#include "game.h"
+#include "collision.h"
+#include "render.h"
+#include "leaderboard.h"
+#include "leaderboard_proto.h"
+#include "loader.h"
+#include "telemetry.h"
+#include "perf.h"
+#include "bot.h"
+#include "trace.h"
+#include "gl_instrument.h"
+#include "replay.h"
 
 // --- Šejderi ---
-const char* vertexShaderSource = "#version 330 core\nlayout (location = 0) in vec2 aPos; uniform vec2 u_Translate; uniform vec2 u_Scale; uniform float u_Rotation; void main() { mat2 rot = mat2(cos(u_Rotation), -sin(u_Rotation), sin(u_Rotation), cos(u_Rotation)); vec2 pos = rot * aPos; pos = pos * u_Scale; pos = pos + u_Translate; gl_Position = vec4(pos, 0.0, 1.0); }\0";
-const char* fragmentShaderSource = "#version 330 core\n out vec4 FragColor; uniform vec3 u_Color; void main() { FragColor = vec4(u_Color, 1.0f); }\n\0";
-
-// --- Strukture ---
-typedef struct { float x, y; } Vec2;
-typedef struct { float r, g, b; } Vec3;
-typedef struct { Vec2 position; Vec2 size; Vec2 velocity; Vec3 color; float rotation; int active; } GameObject;
-typedef struct { Vec2 position; float speed; int layer; } Star;
-typedef struct { int score; char timestamp[30]; } LeaderboardEntry;
+// Instancirano crtanje: po-instanci podaci stizu spakovani (vidi render.h) i dekodiraju se kao normalizovani atributi
+const char* vertexShaderSource = "#version 330 core\nlayout (location = 0) in vec2 aPos; layout (location = 1) in vec2 iPos; layout (location = 2) in float iAngle; layout (location = 3) in vec2 iSize; layout (location = 4) in vec4 iColor; uniform float u_PosRange; uniform float u_SizeRange; out vec4 vColor; void main() { float a = iAngle * 6.28318531; mat2 rot = mat2(cos(a), -sin(a), sin(a), cos(a)); vec2 pos = rot * aPos; pos = pos * (iSize * iSize * u_SizeRange); pos = pos + iPos * u_PosRange; gl_Position = vec4(pos, 0.0, 1.0); vColor = iColor; }\0";
+const char* fragmentShaderSource = "#version 330 core\n in vec4 vColor; out vec4 FragColor; void main() { FragColor = vColor; }\n\0";
 
 // --- Globalno stanje ---
 unsigned int shaderProgram;
-GameObject player;
-GameObject asteroids[MAX_ASTEROIDS];
-GameObject bullets[MAX_BULLETS];
-Star stars[MAX_STARS];
-LeaderboardEntry leaderboard[LEADERBOARD_SIZE];
-int leaderboard_count = 0;
-int score = 0;
-int game_over = 0;
-double asteroid_spawn_timer = 0.0, shoot_cooldown = 0.0;
-int asteroids_missed = 0, missed_asteroids_rule_enabled = 1;
-double game_over_animation_timer = 0.0;
-
-// Boja asteroida: ciklus nijanse (HSV) za "vibriranje" boja tokom pada
-static float asteroid_hue[MAX_ASTEROIDS];
-static float asteroid_hue_speed[MAX_ASTEROIDS];
-
-// --- Prototipovi funkcija ---
-void initialize_game();
-void save_leaderboard();
-
-// HSV -> RGB konverzija (h,s,v u [0,1])
-static inline Vec3 hsv_to_rgb(float h, float s, float v) {
-    if (s <= 0.0f) return (Vec3){v, v, v};
-    h = fmodf(h, 1.0f); if (h < 0.0f) h += 1.0f;
-    float hf = h * 6.0f;
-    int i = (int)floorf(hf);
-    float f = hf - i;
-    float p = v * (1.0f - s);
-    float q = v * (1.0f - s * f);
-    float t = v * (1.0f - s * (1.0f - f));
-    switch (i % 6) {
-        case 0: return (Vec3){v, t, p};
-        case 1: return (Vec3){q, v, p};
-        case 2: return (Vec3){p, v, t};
-        case 3: return (Vec3){p, q, v};
-        case 4: return (Vec3){t, p, v};
-        default: return (Vec3){v, p, q};
-    }
+GameState game = { .missed_asteroids_rule_enabled = 1 };
+// Plasman poslednje igre medju svim igrama ikad (za ekran kraja igre)
+uint64_t last_rank = 0, last_total = 0;
+int score_percentiles[3] = {0, 0, 0};   // p50/p90/p99 svih igara
+// Vremena frejmova tekuce igre (za telemetriju)
+static FrameTimeStats run_frames;
+static uint32_t forced_seed = 0;   // --seed N: prva igra krece iz zadatog semena (i 0)
+static int seed_forced = 0;
+// Autopilot (taster B ili --bot [nivo]); posle kraja igre sam pokrece novu
+static Bot autopilot;
+static int autopilot_on = 0, autopilot_skill = BOT_NORMAL;
+static int run_used_autopilot = 0;   // takve igre ne ulaze u leaderboard
+// Ulaz ovog frejma (tastatura ili bot); petlja ga snima pa primenjuje
+static GameInput frame_input;
+// --record DIR: svaka igra se snima u DIR/replay-<seme>.rpl
+static const char* record_dir = NULL;
+static ReplayWriter recorder;
+
+static void finish_recording() {
+    if (recorder.file == NULL) return;
+    if (!replay_writer_close(&recorder)) fprintf(stderr, "Greska pri upisu snimka\n");
 }
 
-// --- Funkcije za Leaderboard ---
-void print_full_leaderboard() {
-    printf("\n--- KOMPLETAN LEADERBOARD ---\n");
-    for (int i = 0; i < leaderboard_count; i++) printf("%d. %d poena (%s)\n", i + 1, leaderboard[i].score, leaderboard[i].timestamp);
-    printf("---------------------------\n"); fflush(stdout);
+static void start_recording() {
+    finish_recording();
+    if (record_dir == NULL) return;
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/replay-%u.rpl", record_dir, game.seed);
+    if (!replay_writer_open(&recorder, path, &game, 0)) { perror(path); return; }
+    printf("Snimak: %s\n", path);
+    fflush(stdout);
 }
-int compare_scores(const void* a, const void* b) { return ((LeaderboardEntry*)b)->score - ((LeaderboardEntry*)a)->score; }
-void load_leaderboard() {
-    FILE* file = fopen("leaderboard.txt", "r"); if (file == NULL) return;
-    leaderboard_count = 0;
-    while (leaderboard_count < LEADERBOARD_SIZE && fscanf(file, "%d %[^\n]", &leaderboard[leaderboard_count].score, leaderboard[leaderboard_count].timestamp) == 2) leaderboard_count++;
-    fclose(file); qsort(leaderboard, leaderboard_count, sizeof(LeaderboardEntry), compare_scores);
-}
-void save_leaderboard() {
-    FILE* file = fopen("leaderboard.txt", "w"); if (file == NULL) return;
-    for (int i = 0; i < leaderboard_count; i++) fprintf(file, "%d %s\n", leaderboard[i].score, leaderboard[i].timestamp);
-    fclose(file);
+
+// Nova igra sa novim semenom; seme se belezi u telemetriji pa se niz asteroida moze ponoviti
+// (tacan tok igre zavisi i od vremena frejmova, njega ponavlja tek snimak, --record)
+static void start_new_game() {
+    uint32_t seed = seed_forced ? forced_seed : (uint32_t)time(NULL) ^ ((uint32_t)(glfwGetTime() * 1e6) * 2654435761u);
+    seed_forced = 0;
+    initialize_game(&game, seed);
+    frame_stats_reset(&run_frames);
+    run_used_autopilot = autopilot_on;
+    if (autopilot_on) bot_init(&autopilot, autopilot_skill, seed);
+    start_recording();
 }
-void add_score_to_leaderboard(int new_score) {
-    if (leaderboard_count < LEADERBOARD_SIZE || (leaderboard_count > 0 && new_score > leaderboard[leaderboard_count - 1].score)) {
-        time_t t = time(NULL); struct tm* tm_info = localtime(&t);
-        int index_to_add = (leaderboard_count < LEADERBOARD_SIZE) ? leaderboard_count++ : LEADERBOARD_SIZE - 1;
-        leaderboard[index_to_add].score = new_score;
-        strftime(leaderboard[index_to_add].timestamp, 30, "%Y-%m-%d %H:%M:%S", tm_info);
-        qsort(leaderboard, leaderboard_count, sizeof(LeaderboardEntry), compare_scores);
-        save_leaderboard();
-    }
+
+// --- Pregled snimka (--replay FILE) ---
+// Space pauza, strelice levo/desno premotavanje (REPLAY_SCRUB_SPEED puta brze,
+// i unazad), ',' i '.' korak unazad/unapred, Home/End pocetak/kraj.
+// Svaki skok ide preko najblizeg kljucnog frejma (replay_seek).
+#define REPLAY_SCRUB_SPEED 8.0
+static Replay replay;
+static int replay_mode = 0, replay_paused = 0;
+
+static void replay_jump(uint32_t tick) {
+    if (!replay_seek(&replay, &game, tick)) { fprintf(stderr, "Snimak je ostecen oko koraka %u\n", tick); replay_paused = 1; }
 }
 
-// --- Inicijalizacija igre ---
-void initialize_game() {
-    // Reset globalnog stanja
-    score = 0;
-    game_over = 0;
-    asteroid_spawn_timer = 0.0;
-    shoot_cooldown = 0.0;
-    asteroids_missed = 0;
-    game_over_animation_timer = 0.0;
-
-    // Igrac
-    player.position = (Vec2){0.0f, -0.8f};
-    player.size = (Vec2){0.12f, 0.12f};
-    player.velocity = (Vec2){1.5f, 0.0f};
-    player.color = (Vec3){0.2f, 0.8f, 1.0f};
-    player.rotation = 0.0f;
-    player.active = 1;
-
-    // Metci i asteroidi
-    for (int i = 0; i < MAX_BULLETS; i++) {
-        bullets[i].active = 0;
-        bullets[i].rotation = 0.0f;
-        bullets[i].size = (Vec2){0.02f, 0.05f};
-        bullets[i].color = (Vec3){1.0f, 1.0f, 0.0f};
-    }
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        asteroids[i].active = 0;
-        asteroids[i].rotation = 0.0f;
-        asteroids[i].size = (Vec2){0.1f, 0.1f};
-        // Inicijalne vrednosti za ciklus boje; konkretna boja se postavlja pri spawnu
-        asteroid_hue[i] = (rand() % 1000) / 1000.0f;
-        asteroid_hue_speed[i] = 0.15f + ((rand() % 200) / 1000.0f); // 0.15..0.35
-        asteroids[i].color = hsv_to_rgb(asteroid_hue[i], 0.85f, 0.95f);
+static void replay_input(GLFWwindow* window, double dt) {
+    static int space_was, comma_was, period_was;
+    int space = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+    int comma = glfwGetKey(window, GLFW_KEY_COMMA) == GLFW_PRESS;
+    int period = glfwGetKey(window, GLFW_KEY_PERIOD) == GLFW_PRESS;
+    if (space && !space_was) replay_paused = !replay_paused;
+    if (comma && !comma_was) { replay_paused = 1; if (replay.tick > 0) replay_jump(replay.tick - 1); }
+    if (period && !period_was) { replay_paused = 1; replay_step(&replay, &game); }
+    space_was = space; comma_was = comma; period_was = period;
+    if (glfwGetKey(window, GLFW_KEY_HOME) == GLFW_PRESS) replay_jump(0);
+    if (glfwGetKey(window, GLFW_KEY_END) == GLFW_PRESS) replay_jump(replay.tick_count);
+
+    double rate = replay_paused ? 0.0 : 1.0;
+    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) rate = REPLAY_SCRUB_SPEED;
+    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) rate = -REPLAY_SCRUB_SPEED;
+    if (rate > 0.0) {
+        // Unapred korak po korak dok snimak ne stigne realno vreme
+        double target = game.run_time + dt * rate;
+        while (game.run_time < target && replay_step(&replay, &game)) {}
+    } else if (rate < 0.0 && replay.tick > 0 && replay.tick_count > 0) {
+        // Unazad nema koraka, pa skok za odgovarajuci broj prosecnih koraka
+        double average_dt = replay.total_time / replay.tick_count;
+        uint32_t back = average_dt > 0.0 ? (uint32_t)ceil(dt * -rate / average_dt) : 1;
+        replay_jump(back < replay.tick ? replay.tick - back : 0);
     }
+}
 
-    // Zvezde (paralaksa)
-    for (int i = 0; i < MAX_STARS; i++) {
-        stars[i].position = (Vec2){ ((rand() % 2000) / 1000.0f) - 1.0f, ((rand() % 2000) / 1000.0f) - 1.0f };
-        stars[i].layer = rand() % NUM_LAYERS;
-        float base = 0.15f;
-        if (stars[i].layer == 0) stars[i].speed = base * 0.6f;
-        else if (stars[i].layer == 1) stars[i].speed = base * 1.0f;
-        else stars[i].speed = base * 1.5f;
+// Vremena frejmova po fazama i overlay (F3)
+static FrameRing frame_ring;
+static FramePercentiles perf_shown[PHASE_COUNT + 1];
+static double perf_next_refresh = 0.0;
+static int show_perf = 0;
+
+#ifdef PROFILE
+// --trace FILE: zone se upisuju na izlazu; F4 upisuje trenutne prstenove u isti fajl
+static const char* trace_path = "trace.json";
+static void dump_trace() {
+    long n = trace_dump(trace_path);
+    if (n < 0) perror(trace_path); else printf("Trace: %ld zona u %s\n", n, trace_path);
+    fflush(stdout);
+}
+#endif
+
+// Globalni pregled svih profila: gradi se na loader niti tek kad se zatrazi (taster G na kraju igre)
+static LeaderboardEntry global_top[LEADERBOARD_SIZE];
+static int global_count = 0, show_global = 0;
+static LoadTask global_task;
+// Ucitavanje leaderboard-a pri pokretanju (vidi load_leaderboard_task)
+static LoadTask leaderboard_task;
+
+// Kopija tabele profila iz memorije: ima i rezultate koje I/O nit jos nije upisala na disk
+static LeaderboardEntry global_local[LEADERBOARD_SIZE];
+static int global_local_count = 0;
+
+// Disk (ili server) + kopija iz memorije; zapis koji je vec na disku se ne broji dvaput
+static void build_global_view(void* arg) {
+    (void)arg;
+    LeaderboardEntry disk[LEADERBOARD_SIZE], extra[LEADERBOARD_SIZE];
+    char used[LEADERBOARD_SIZE] = {0};
+    int n = leaderboard_global_top(disk, LEADERBOARD_SIZE), extra_count = 0;
+    for (int i = 0; i < global_local_count; i++) {
+        int j = 0;
+        while (j < n && (used[j] || disk[j].score != global_local[i].score || disk[j].epoch_time != global_local[i].epoch_time)) j++;
+        if (j < n) used[j] = 1; else extra[extra_count++] = global_local[i];
     }
+    int a = 0, b = 0;
+    for (global_count = 0; global_count < LEADERBOARD_SIZE && (a < n || b < extra_count); global_count++)
+        global_top[global_count] = (b == extra_count || (a < n && disk[a].score >= extra[b].score)) ? disk[a++] : extra[b++];
+}
+// Dok loader radi, frejm ne cita global_top ni global_local (loader_done je 0 od predaje)
+static void refresh_global_view() {
+    if (global_task.run != NULL && !loader_done(&global_task)) return;
+    global_local_count = loader_done(&leaderboard_task) ? leaderboard_count : 0;
+    memcpy(global_local, leaderboard, (size_t)global_local_count * sizeof(LeaderboardEntry));
+    global_task = LOAD_TASK("global leaderboard", build_global_view, NULL);
+    loader_submit(&global_task);
 }
-
-// --- Funkcije za igru ---
-void shoot_bullet() { for (int i = 0; i < MAX_BULLETS; i++) if (!bullets[i].active) { bullets[i] = (GameObject){player.position, {0.02f, 0.05f}, {0.0f, 4.0f}, {1.0f, 1.0f, 0.0f}, 0.0f, 1}; return; } }
-void spawn_asteroid() { for (int i = 0; i < MAX_ASTEROIDS; i++) if (!asteroids[i].active) { float size = ((rand() % 5) / 100.0f) + 0.08f; int idx = i; asteroid_hue[idx] = (rand() % 1000) / 1000.0f; asteroid_hue_speed[idx] = 0.2f + ((rand() % 300) / 1000.0f); Vec3 col = hsv_to_rgb(asteroid_hue[idx], 0.9f, 0.95f); asteroids[i] = (GameObject){{((rand() % 200) / 100.0f) - 1.0f, 1.1f}, {size, size}, {0.0f, -(((rand() % 10) / 100.0f) + 0.2f + (score * 0.001f))}, col, 0.0f, 1}; return; } }
 
 // IZMENJENO: processInput sada ima i taster 'R' za restart
 void processInput(GLFWwindow *window, double dt) {
+    TRACE_ZONE("processInput");
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) glfwSetWindowShouldClose(window, 1);
     
     static int m_key_was_pressed = 0;
     int m_key_is_pressed = glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS;
-    if (m_key_is_pressed && !m_key_was_pressed) {
-        missed_asteroids_rule_enabled = !missed_asteroids_rule_enabled;
-        printf("Pravilo promasenih asteroida je sada: %s\n", missed_asteroids_rule_enabled ? "UKLJUCENO" : "ISKLJUCENO");
+    if (m_key_is_pressed && !m_key_was_pressed && !replay_mode) {
+        game.missed_asteroids_rule_enabled = !game.missed_asteroids_rule_enabled;
+        printf("Pravilo promasenih asteroida je sada: %s\n", game.missed_asteroids_rule_enabled ? "UKLJUCENO" : "ISKLJUCENO");
         fflush(stdout);
     }
     m_key_was_pressed = m_key_is_pressed;
 
+    static int f3_was_pressed = 0;
+    int f3_is_pressed = glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS;
+    if (f3_is_pressed && !f3_was_pressed) { show_perf = !show_perf; perf_next_refresh = 0.0; }
+    f3_was_pressed = f3_is_pressed;
+#ifdef PROFILE
+    static int f4_was_pressed = 0;
+    int f4_is_pressed = glfwGetKey(window, GLFW_KEY_F4) == GLFW_PRESS;
+    if (f4_is_pressed && !f4_was_pressed) dump_trace();
+    f4_was_pressed = f4_is_pressed;
+#endif
+    if (replay_mode) { replay_input(window, dt); return; }
+
+    static int b_key_was_pressed = 0;
+    int b_key_is_pressed = glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS;
+    if (b_key_is_pressed && !b_key_was_pressed) {
+        autopilot_on = !autopilot_on;
+        if (autopilot_on) { bot_init(&autopilot, autopilot_skill, game.seed); run_used_autopilot |= !game.game_over; }
+        printf("Autopilot (%s): %s\n", bot_skill_name(autopilot_skill), autopilot_on ? "UKLJUCEN" : "ISKLJUCEN");
+        fflush(stdout);
+    }
+    b_key_was_pressed = b_key_is_pressed;
+    frame_input = (GameInput){ 0 };
+
     // NOVO: Logika za restart
-    if (game_over) {
-        if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS) {
-            initialize_game();
+    if (game.game_over) {
+        if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS || (autopilot_on && game.game_over_animation_timer > 4.5)) {
+            start_new_game();
         }
+        static int g_key_was_pressed = 0;
+        int g_key_is_pressed = glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS;
+        if (g_key_is_pressed && !g_key_was_pressed) { show_global = !show_global; if (show_global) refresh_global_view(); }
+        g_key_was_pressed = g_key_is_pressed;
         return;
     }
 
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) player.position.x -= player.velocity.x * dt;
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) player.position.x += player.velocity.x * dt;
-
-    if (player.position.x > 1.0f) player.position.x = 1.0f;
-    if (player.position.x < -1.0f) player.position.x = -1.0f;
-    
-    shoot_cooldown -= dt;
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS && shoot_cooldown <= 0.0) {
-        shoot_bullet();
-        shoot_cooldown = 0.25;
-    }
+    GameInput in = {
+        .left = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS,
+        .right = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS,
+        .shoot = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS,
+    };
+    if (autopilot_on) bot_think(&autopilot, &game, dt, &in);
+    frame_input = in;
 }
 
 // --- Funkcije za crtanje ---
-void draw_rect(float x, float y, float w, float h, int trans_loc, int scale_loc, int rot_loc, int color_loc, Vec3 c) {
-    glUniform2f(trans_loc, x, y); glUniform2f(scale_loc, w, h);
-    glUniform1f(rot_loc, 0.0f); glUniform3f(color_loc, c.r, c.g, c.b);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+void draw_rect(float x, float y, float w, float h, InstanceBatch* ui, Vec3 c) {
+    batch_push(ui, (Vec2){x, y}, (Vec2){w, h}, 0.0f, c);
 }
-void draw_digit(int digit, float x, float y, float size, int trans_loc, int scale_loc, int rot_loc, int color_loc, Vec3 c) {
+void draw_digit(int digit, float x, float y, float size, InstanceBatch* ui, Vec3 c) {
     // Novi prikaz cifara: jednostavan 3x5 "pixel" font umesto 7-segmentnog
     // Razlog: 7-segmentna verzija je imala nelogicne duzine segmenata i
     // preklapanja pa su se cifre iskrivljavale (videlo se kao "IAA").
@@ -220,137 +258,275 @@ void draw_digit(int digit, float x, float y, float size, int trans_loc, int scal
             if (p[r*3 + col] == '1') {
                 float cx = start_x + col * step;
                 float cy = start_y - r * step;
-                draw_rect(cx, cy, px, px, trans_loc, scale_loc, rot_loc, color_loc, c);
+                draw_rect(cx, cy, px, px, ui, c);
             }
         }
     }
 }
-void draw_score(int score_val, float x, float y, float size, int trans_loc, int scale_loc, int rot_loc, int color_loc, Vec3 c) {
-    if (score_val == 0) { draw_digit(0, x, y, size, trans_loc, scale_loc, rot_loc, color_loc, c); return; }
-    char buffer[16]; sprintf(buffer, "%d", score_val);
+void draw_score(int score_val, float x, float y, float size, InstanceBatch* ui, Vec3 c) {
+    if (score_val == 0) { draw_digit(0, x, y, size, ui, c); return; }
+    char* buffer = arena_printf(&frame_arena, "%d", score_val);
+    if (buffer == NULL) return;
     int num_digits = (int)strlen(buffer);
     // Blago uvecan razmak izmedju cifara radi citkosti
     float advance = size * 6.6f;            // bilo 6.0f
     float start_x = x - (num_digits - 1) * (advance * 0.5f);
     for (int i = 0; i < num_digits; i++) {
-        draw_digit(buffer[i] - '0', start_x + i * advance, y, size, trans_loc, scale_loc, rot_loc, color_loc, c);
+        draw_digit(buffer[i] - '0', start_x + i * advance, y, size, ui, c);
     }
 }
 
 // ISPRAVLJENO: draw_game_over_screen sa ispravnim i jednostavnijim koordinatama
-void draw_game_over_screen(int trans_loc, int scale_loc, int rot_loc, int color_loc, float anim_scale) {
+void draw_game_over_screen(InstanceBatch* ui, float anim_scale) {
     Vec3 c = {1.0f, 0.1f, 0.1f};
     float w = 0.05f * anim_scale, h = 0.05f * anim_scale;
     float y_offset = (1.0f - anim_scale) * 1.8f;
     float y_base = y_offset + 0.35f; // pomeranje natpisa ka vrhu ekrana
 
     // G
-    draw_rect(-0.8f, 0.4f + y_base, w*3, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.9f, 0.3f + y_base, w, h*3, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.8f, 0.2f + y_base, w*3, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.7f, 0.25f + y_base, w, h, trans_loc, scale_loc, rot_loc, color_loc, c);
+    draw_rect(-0.8f, 0.4f + y_base, w*3, h, ui, c); draw_rect(-0.9f, 0.3f + y_base, w, h*3, ui, c); draw_rect(-0.8f, 0.2f + y_base, w*3, h, ui, c); draw_rect(-0.7f, 0.25f + y_base, w, h, ui, c);
     // A
-    draw_rect(-0.5f, 0.4f + y_base, w*3, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.6f, 0.3f + y_base, w, h*3, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.4f, 0.3f + y_base, w, h*3, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.5f, 0.3f + y_base, w*3, h, trans_loc, scale_loc, rot_loc, color_loc, c);
+    draw_rect(-0.5f, 0.4f + y_base, w*3, h, ui, c); draw_rect(-0.6f, 0.3f + y_base, w, h*3, ui, c); draw_rect(-0.4f, 0.3f + y_base, w, h*3, ui, c); draw_rect(-0.5f, 0.3f + y_base, w*3, h, ui, c);
     // M
-    draw_rect(-0.15f, 0.3f + y_base, w, h*5, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.15f, 0.3f + y_base, w, h*5, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.075f, 0.4f + y_base, w, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.0f, 0.3f + y_base, w, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.075f, 0.4f + y_base, w, h, trans_loc, scale_loc, rot_loc, color_loc, c);
+    draw_rect(-0.15f, 0.3f + y_base, w, h*5, ui, c); draw_rect(0.15f, 0.3f + y_base, w, h*5, ui, c); draw_rect(-0.075f, 0.4f + y_base, w, h, ui, c); draw_rect(0.0f, 0.3f + y_base, w, h, ui, c); draw_rect(0.075f, 0.4f + y_base, w, h, ui, c);
     // E
-    draw_rect(0.35f, 0.3f + y_base, w, h*5, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.45f, 0.4f + y_base, w*2, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.45f, 0.3f + y_base, w*2, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.45f, 0.2f + y_base, w*2, h, trans_loc, scale_loc, rot_loc, color_loc, c);
+    draw_rect(0.35f, 0.3f + y_base, w, h*5, ui, c); draw_rect(0.45f, 0.4f + y_base, w*2, h, ui, c); draw_rect(0.45f, 0.3f + y_base, w*2, h, ui, c); draw_rect(0.45f, 0.2f + y_base, w*2, h, ui, c);
 
     // O
-    draw_rect(-0.6f, -0.1f + y_base, w*3, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.7f, -0.2f + y_base, w, h*3, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.5f, -0.2f + y_base, w, h*3, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.6f, -0.3f + y_base, w*3, h, trans_loc, scale_loc, rot_loc, color_loc, c);
+    draw_rect(-0.6f, -0.1f + y_base, w*3, h, ui, c); draw_rect(-0.7f, -0.2f + y_base, w, h*3, ui, c); draw_rect(-0.5f, -0.2f + y_base, w, h*3, ui, c); draw_rect(-0.6f, -0.3f + y_base, w*3, h, ui, c);
     // V
-    draw_rect(-0.3f, -0.15f + y_base, w, h*4, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.1f, -0.15f + y_base, w, h*4, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.25f, -0.3f + y_base, w, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(-0.2f, -0.35f + y_base, w, h, trans_loc, scale_loc, rot_loc, color_loc, c);
+    draw_rect(-0.3f, -0.15f + y_base, w, h*4, ui, c); draw_rect(-0.1f, -0.15f + y_base, w, h*4, ui, c); draw_rect(-0.25f, -0.3f + y_base, w, h, ui, c); draw_rect(-0.2f, -0.35f + y_base, w, h, ui, c);
     // E
-    draw_rect(0.1f, -0.2f + y_base, w, h*5, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.2f, 0.0f + y_base, w*2, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.2f, -0.2f + y_base, w*2, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.2f, -0.4f + y_base, w*2, h, trans_loc, scale_loc, rot_loc, color_loc, c);
+    draw_rect(0.1f, -0.2f + y_base, w, h*5, ui, c); draw_rect(0.2f, 0.0f + y_base, w*2, h, ui, c); draw_rect(0.2f, -0.2f + y_base, w*2, h, ui, c); draw_rect(0.2f, -0.4f + y_base, w*2, h, ui, c);
     // R
-    draw_rect(0.5f, -0.2f + y_base, w, h*5, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.6f, 0.0f + y_base, w*2, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.7f, -0.1f + y_base, w, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.6f, -0.2f + y_base, w*2, h, trans_loc, scale_loc, rot_loc, color_loc, c); draw_rect(0.65f, -0.35f + y_base, w, h*2, trans_loc, scale_loc, rot_loc, color_loc, c);
+    draw_rect(0.5f, -0.2f + y_base, w, h*5, ui, c); draw_rect(0.6f, 0.0f + y_base, w*2, h, ui, c); draw_rect(0.7f, -0.1f + y_base, w, h, ui, c); draw_rect(0.6f, -0.2f + y_base, w*2, h, ui, c); draw_rect(0.65f, -0.35f + y_base, w, h*2, ui, c);
 
     if (anim_scale < 1.0) return;
     
     // Trenutni skor
-    draw_score(score, 0.0f, -0.3f, 0.02f, trans_loc, scale_loc, rot_loc, color_loc, (Vec3){1.0f, 1.0f, 0.5f});
+    draw_score(game.score, 0.0f, -0.3f, 0.02f, ui, (Vec3){1.0f, 1.0f, 0.5f});
+    // Plasman levo, ukupan broj igara desno
+    if (last_total > 0) {
+        draw_score((int)last_rank, -0.6f, -0.3f, 0.012f, ui, (Vec3){0.4f, 0.9f, 1.0f});
+        draw_score(last_total > 999999999 ? 999999999 : (int)last_total, 0.6f, -0.3f, 0.012f, ui, (Vec3){0.5f, 0.5f, 0.5f});
+    }
+
+    // Percentili svih igara (p50, p90, p99) sitno pri dnu
+    if (last_total > 0) for (int i = 0; i < 3; i++) draw_score(score_percentiles[i], -0.5f + i * 0.5f, -0.95f, 0.008f, ui, (Vec3){0.45f, 0.45f, 0.6f});
 
+    // Leaderboard profila, ili globalni (svi profili) posle 'G'; traka levo znaci globalni pregled
+    // Pregled snimka ne ceka ucitavanje, pa do tada loader nit jos pise leaderboard
+    const LeaderboardEntry* rows = leaderboard; int row_count = loader_done(&leaderboard_task) ? leaderboard_count : 0;
+    if (show_global) {
+        int ready = loader_done(&global_task);
+        draw_rect(-0.3f, -0.68f, 0.02f, 0.42f, ui, ready ? (Vec3){0.3f, 0.8f, 1.0f} : (Vec3){0.2f, 0.2f, 0.3f});
+        if (ready) { rows = global_top; row_count = global_count; }
+    }
     // Leaderboard: top 3 razlicite boje, ostali sivi
-    for (int i = 0; i < 4 && i < leaderboard_count; i++) {
+    for (int i = 0; i < 4 && i < row_count; i++) {
         Vec3 lc;
         if (i == 0) lc = (Vec3){1.0f, 0.84f, 0.0f};       // zlato
         else if (i == 1) lc = (Vec3){0.75f, 0.75f, 0.75f}; // srebro
         else if (i == 2) lc = (Vec3){0.8f, 0.5f, 0.2f};    // bronza
         else lc = (Vec3){0.5f, 0.5f, 0.5f};                // sivi
-        draw_score(leaderboard[i].score, 0.0f, -0.5f - i * 0.12f, 0.015f, trans_loc, scale_loc, rot_loc, color_loc, lc);
+        draw_score(rows[i].score, 0.0f, -0.5f - i * 0.12f, 0.015f, ui, lc);
     }
 }
 
-// --- Glavna logika igre ---
-void update_state(GLFWwindow* window, double dt) {
-    for (int i = 0; i < MAX_STARS; i++) {
-        stars[i].position.y -= stars[i].speed * dt;
-        if (stars[i].position.y < -1.1f) {
-            stars[i].position.y = 1.1f;
-            stars[i].position.x = ((rand() % 2000) / 1000.0f) - 1.0f;
-        }
-    }
-    if (game_over) return;
-    for (int i = 0; i < MAX_BULLETS; i++) if (bullets[i].active) {
-        bullets[i].position.y += bullets[i].velocity.y * dt;
-        if (bullets[i].position.y > 1.1f) bullets[i].active = 0;
+// --- Ucitavanje u pozadini ---
+// Leaderboard (snimak, zurnal, uvoz, I/O nit) se ucitava na loader niti dok se prozor dize
+typedef struct { int argc; char** argv; } StartupArgs;
+static StartupArgs startup_args;
+
+static void import_leaderboards(int argc, char** argv);
+static const char* server_socket(int argc, char** argv);
+
+static void load_leaderboard_task(void* arg) {
+    StartupArgs* args = arg;
+    load_leaderboard();
+    import_leaderboards(args->argc, args->argv);
+    const char* server = server_socket(args->argc, args->argv);
+    if (server != NULL) leaderboard_use_server(server);
+    leaderboard_io_start();
+}
+
+// Frejm nit ceka samo ako ucitavanje jos traje
+static void wait_for_leaderboard() {
+    if (loader_done(&leaderboard_task)) return;
+    double t0 = glfwGetTime();
+    loader_wait(&leaderboard_task);
+    printf("Cekanje na leaderboard: %.1f ms\n", (glfwGetTime() - t0) * 1000.0);
+}
+
+// Traka napretka snimka na dnu ekrana
+static void draw_replay_bar(InstanceBatch* ui) {
+    float done = replay.tick_count ? (float)replay.tick / replay.tick_count : 0.0f;
+    draw_rect(0.0f, -0.97f, 1.9f, 0.012f, ui, (Vec3){0.25f, 0.25f, 0.3f});
+    draw_rect(-0.95f + 0.95f * done, -0.97f, 1.9f * done, 0.012f, ui, replay_paused ? (Vec3){1.0f, 0.8f, 0.3f} : (Vec3){0.4f, 0.8f, 1.0f});
+}
+
+// --- Perf overlay ---
+// Redovi: ukupno, input, update, render, swap; kolone p50/p95/p99/max u desetinkama ms
+// (167 = 16.7 ms). Ispod je grafik ukupnog vremena poslednjih frejmova.
+#define PERF_GRAPH_FRAMES 160
+void draw_perf_overlay(InstanceBatch* ui, double now) {
+    static const Vec3 phase_colors[PHASE_COUNT + 1] = {
+        {0.9f, 0.6f, 1.0f}, {0.4f, 0.9f, 0.4f}, {1.0f, 0.8f, 0.3f}, {0.4f, 0.7f, 1.0f}, {1.0f, 1.0f, 1.0f}
+    };
+    if (now >= perf_next_refresh) {
+        float* scratch = ARENA_NEW(&frame_arena, float, FRAME_RING_SIZE);
+        if (scratch != NULL) for (int p = 0; p <= PHASE_COUNT; p++) frame_ring_percentiles(&frame_ring, p, scratch, &perf_shown[p]);
+        perf_next_refresh = now + 0.25;
     }
-    double spawn_interval = 1.0 - (score * 0.002);
-    if (spawn_interval < 0.2) spawn_interval = 0.2;
-    asteroid_spawn_timer += dt;
-    if (asteroid_spawn_timer > spawn_interval) {
-        spawn_asteroid();
-        asteroid_spawn_timer = 0.0;
+    for (int row = 0; row <= PHASE_COUNT; row++) {
+        int p = row == 0 ? PHASE_TOTAL : row - 1;
+        float y = 0.93f - row * 0.07f;
+        const FramePercentiles* f = &perf_shown[p];
+        float vals[4] = { f->p50, f->p95, f->p99, f->max };
+        draw_rect(-0.95f, y, 0.025f, 0.025f, ui, phase_colors[p]);
+        for (int c = 0; c < 4; c++) {
+            // Rep (p99/max) iznad dvostruke medijane se boji crveno
+            Vec3 col = (c >= 2 && vals[c] > 2.0f * f->p50 + 1.0f) ? (Vec3){1.0f, 0.3f, 0.3f} : phase_colors[p];
+            draw_score((int)(vals[c] * 10.0f + 0.5f), -0.78f + c * 0.2f, y, 0.005f, ui, col);
+        }
     }
-    for (int i = 0; i < MAX_ASTEROIDS; i++) if (asteroids[i].active) {
-        asteroids[i].position.y += asteroids[i].velocity.y * dt;
-        asteroids[i].rotation += 1.0f * dt;
-        // Ažuriraj nijansu za "vibriranje" boje dok asteroid pada
-        asteroid_hue[i] += asteroid_hue_speed[i] * (float)dt;
-        if (asteroid_hue[i] >= 1.0f) asteroid_hue[i] -= 1.0f;
-        if (asteroid_hue[i] < 0.0f) asteroid_hue[i] += 1.0f;
-        asteroids[i].color = hsv_to_rgb(asteroid_hue[i], 0.9f, 0.95f);
-        if (asteroids[i].position.y < -1.2f) { asteroids[i].active = 0; asteroids_missed++; }
+    // 16.7 ms = 0.1 visine; zeleno do 60 fps, zuto do 30 fps, crveno preko
+    float base = 0.48f;
+    draw_rect(-0.95f + PERF_GRAPH_FRAMES * 0.0025f, base + 0.1f, PERF_GRAPH_FRAMES * 0.005f, 0.002f, ui, (Vec3){0.3f, 0.3f, 0.3f});
+    for (uint32_t i = 0; i < PERF_GRAPH_FRAMES && i < frame_ring.count; i++) {
+        float ms = frame_ring_recent(&frame_ring, PHASE_TOTAL, i);
+        float h = fminf(ms * 0.006f, 0.4f);
+        Vec3 col = ms <= 16.7f ? (Vec3){0.3f, 0.9f, 0.3f} : ms <= 33.4f ? (Vec3){1.0f, 0.85f, 0.2f} : (Vec3){1.0f, 0.25f, 0.25f};
+        draw_rect(-0.95f + (PERF_GRAPH_FRAMES - 1 - i) * 0.005f, base + h * 0.5f, 0.004f, h, ui, col);
     }
+}
 
-    for (int i = 0; i < MAX_BULLETS; i++) {
-        if (!bullets[i].active) continue;
-        for (int j = 0; j < MAX_ASTEROIDS; j++) {
-            if (!asteroids[j].active) continue;
-            float r1 = bullets[i].size.y / 2.0f, r2 = asteroids[j].size.x / 2.0f;
-            float dx = bullets[i].position.x - asteroids[j].position.x, dy = bullets[i].position.y - asteroids[j].position.y;
-            if ((dx * dx + dy * dy) < (r1 + r2)*(r1 + r2)) {
-                bullets[i].active = 0; asteroids[j].active = 0; score += 10; break; 
-            }
-        }
+// --- Kraj igre ---
+void record_game_over() {
+    TRACE_ZONE("record_game_over");
+    finish_recording();
+    telemetry_record_run(&game, &run_frames, 1);
+    wait_for_leaderboard();
+    // Bez plasmana na ekranu kraja igre, da ne stoji plasman prethodne igre pored rezultata bota
+    if (run_used_autopilot) { last_rank = last_total = 0; printf("Igra autopilota (%d) se ne upisuje u leaderboard\n", game.score); fflush(stdout); return; }
+    add_score_to_leaderboard(game.score, (float)game.run_time);
+    if (show_global) refresh_global_view();
+    last_rank = score_index_rank(&score_index, game.score);
+    last_total = score_index_total(&score_index);
+    int32_t around[5];
+    uint64_t first = last_rank > 2 ? last_rank - 2 : 1;
+    int n = score_index_range(&score_index, first, around, 5);
+    printf("Plasman: #%llu od %llu | oko tebe:", (unsigned long long)last_rank, (unsigned long long)last_total);
+    for (int i = 0; i < n; i++) printf(" %d", (int)around[i]);
+    printf("\n");
+    float sp[3], tp[3];
+    if (leaderboard_percentiles(SKETCH_SCORE, sp) && leaderboard_percentiles(SKETCH_SURVIVAL, tp)) {
+        printf("Rezultat p50/p90/p99: %.0f / %.0f / %.0f | prezivljavanje: %.1f / %.1f / %.1f s\n", sp[0], sp[1], sp[2], tp[0], tp[1], tp[2]);
+        for (int i = 0; i < 3; i++) score_percentiles[i] = (int)sp[i];
     }
+    fflush(stdout);
+}
 
-    int should_be_game_over = 0;
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        if (!asteroids[i].active) continue;
-        float r1 = player.size.x / 2.5f, r2 = asteroids[i].size.x / 2.0f;
-        float dx = player.position.x - asteroids[i].position.x, dy = player.position.y - asteroids[i].position.y;
-        if ((dx * dx + dy * dy) < (r1 + r2)*(r1+r2)) { should_be_game_over = 1; break; }
-    }
-    if (missed_asteroids_rule_enabled && asteroids_missed >= MISSED_ASTEROID_LIMIT) {
-        should_be_game_over = 1;
-    }
-    if (should_be_game_over && !game_over) {
-        game_over = 1;
-        player.color.r = 1.0f; player.color.g = 0.2f; player.color.b = 0.2f;
-        add_score_to_leaderboard(score);
-    }
+// Sa --server plasman medju svim igrama stize sa potvrdom servera (posle njegovog fsync-a)
+static void poll_server_rank() {
+    int32_t score; uint64_t rank, total;
+    if (!leaderboard_server_rank(&score, &rank, &total) || !game.game_over || run_used_autopilot || score != game.score) return;
+    last_rank = rank; last_total = total;
+    printf("Plasman na serveru: #%llu od %llu\n", (unsigned long long)rank, (unsigned long long)total);
+    fflush(stdout);
+}
 
-    char title[200];
-    if (game_over) {
-         sprintf(title, "KRAJ IGRE! | Konacan rezultat: %d | Pritisni 'R' za ponovo", score);
+// --- Naslov prozora ---
+void update_title(GLFWwindow* window) {
+    char* title;
+    if (replay_mode) {
+        title = arena_printf(&frame_arena, "Snimak%s | Korak %u/%u | %.1f/%.1f s | Rezultat: %d | [Space] pauza [<-/->] premotavanje [,/.] korak [Home/End]",
+                replay_paused ? " (pauza)" : "", replay.tick, replay.tick_count, game.run_time, replay.total_time, game.score);
+    } else if (game.game_over) {
+         title = arena_printf(&frame_arena, "KRAJ IGRE! | Konacan rezultat: %d | Pritisni 'R' za ponovo | [G] %s leaderboard", game.score, show_global ? "profil" : "globalni");
     } else {
-        sprintf(title, "Svemirski Begunac | Rezultat: %d | Promaseno: %d/%d | Pravilo [M]: %s", 
-                score, asteroids_missed, MISSED_ASTEROID_LIMIT, missed_asteroids_rule_enabled ? "ON" : "OFF");
+        title = arena_printf(&frame_arena, "Svemirski Begunac%s%s | Rezultat: %d | Asteroida: %d | Promaseno: %d/%d | Pravilo [M]: %s | Autopilot [B]: %s", 
+                leaderboard_profile()[0] ? " | Profil: " : "", leaderboard_profile(), game.score, bitset_count(game.asteroid_live, ASTEROID_WORDS), game.asteroids_missed, MISSED_ASTEROID_LIMIT, game.missed_asteroids_rule_enabled ? "ON" : "OFF", autopilot_on ? bot_skill_name(autopilot_skill) : "OFF");
+    }
+    if (title != NULL) glfwSetWindowTitle(window, title);
+}
+
+// --- Instancirano crtanje ---
+#define UI_BATCH_CAPACITY 2048
+
+// Atributi instance (lokacije 1-4) citaju se iz zajednickog instance VBO-a
+static void setup_instance_attribs(unsigned int instanceVBO) {
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(PackedInstance), (void*)offsetof(PackedInstance, x));
+    glVertexAttribPointer(2, 1, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedInstance), (void*)offsetof(PackedInstance, angle));
+    glVertexAttribPointer(3, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedInstance), (void*)offsetof(PackedInstance, sx));
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PackedInstance), (void*)offsetof(PackedInstance, r));
+    for (int i = 1; i <= 4; i++) { glEnableVertexAttribArray(i); glVertexAttribDivisor(i, 1); }
+}
+// Jedan upload i jedan draw call po grupi instanci
+// Instance koje nisu stale u batch (kapacitet je procena, npr. broj cifara u overlay-u)
+static unsigned long instances_dropped = 0;
+
+static void draw_batch(unsigned int vao, unsigned int instanceVBO, const InstanceBatch* b, int vertex_count, int indexed) {
+    if (b->dropped > 0 && instances_dropped == 0) fprintf(stderr, "Batch od %d instanci je pun, visak se ne crta\n", b->capacity);
+    instances_dropped += (unsigned long)b->dropped;
+    if (b->count == 0) return;
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(b->count * sizeof(PackedInstance)), b->items, GL_STREAM_DRAW);
+    if (indexed) glDrawElementsInstanced(GL_TRIANGLES, vertex_count, GL_UNSIGNED_INT, 0, b->count);
+    else glDrawArraysInstanced(GL_TRIANGLES, 0, vertex_count, b->count);
+}
+
+static void report_frame_arena() {
+    arena_report("Frame arena", &frame_arena);
+    if (instances_dropped > 0) { printf("Odbacenih instanci (pun batch): %lu\n", instances_dropped); fflush(stdout); }
+}
+static void report_collisions() { collision_stats_print(&game.collision_stats); }
+// Igra prekinuta zatvaranjem prozora se takodje belezi
+static void finish_telemetry() {
+    if (!game.game_over && game.run_time > 0.0) telemetry_record_run(&game, &run_frames, 0);
+    telemetry_stop();
+}
+
+// --- Komandna linija ---
+// --import FILE (moze vise puta): uvoz tekstualnih leaderboard-a sa drugih kioska
+// --server [SOCKET]: rezultati idu na zajednicki leaderboard server (tools/leaderboard_server.c)
+// --seed N: seme prve igre (npr. iz telemetrije)
+// --profile NAME: leaderboard profila (leaderboards/NAME.*) umesto globalnog
+// --bot [easy|normal|expert]: autopilot od starta (taster B ga pali i gasi)
+// --trace FILE: (samo PROFILE build) Chrome trace JSON zona pri izlasku
+static const char* server_socket(int argc, char** argv) {
+    for (int i = 1; i < argc; i++)
+        if (strcmp(argv[i], "--server") == 0) return (i + 1 < argc && argv[i + 1][0] != '-') ? argv[i + 1] : LB_SERVER_SOCKET;
+    return NULL;
+}
+
+static void import_leaderboards(int argc, char** argv) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--import") != 0) continue;
+        const char* path = argv[++i];
+        double t0 = glfwGetTime();
+        long n = leaderboard_import_text(path);
+        if (n < 0) { fprintf(stderr, "Ne mogu da uvezem %s\n", path); continue; }
+        printf("Uvezeno %ld rezultata iz %s za %.1f ms\n", n, path, (glfwGetTime() - t0) * 1000.0);
     }
-    glfwSetWindowTitle(window, title);
 }
 
 // --- MAIN funkcija ---
-int main() {
+int main(int argc, char** argv) {
+    struct timespec start; timespec_get(&start, TIME_UTC);
     glfwInit();
+    // Leaderboard se ucitava paralelno sa pravljenjem prozora i sejdera; atexit redom
+    // (obrnutim): sacekaj loader, ugasi I/O nit, ispisi leaderboard
+    for (int i = 1; i + 1 < argc; i++)
+        if (strcmp(argv[i], "--profile") == 0 && !leaderboard_set_profile(argv[i + 1])) { fprintf(stderr, "Neispravan profil: %s\n", argv[i + 1]); return 1; }
+    startup_args = (StartupArgs){ argc, argv };
+    leaderboard_task = LOAD_TASK("leaderboard", load_leaderboard_task, &startup_args);
+    loader_submit(&leaderboard_task);
+    atexit(print_full_leaderboard);
+    atexit(leaderboard_io_stop);
+    atexit(loader_shutdown);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -358,6 +534,10 @@ int main() {
     GLFWwindow* window = glfwCreateWindow(800, 900, "Svemirski Begunac", NULL, NULL);
     glfwMakeContextCurrent(window);
     gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+    gl_instrument_install();
+#ifdef GL_INSTRUMENT
+    atexit(gl_instrument_report);
+#endif
 
     unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
@@ -371,8 +551,13 @@ int main() {
     glLinkProgram(shaderProgram);
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
+    glUseProgram(shaderProgram);
+    glUniform1f(glGetUniformLocation(shaderProgram, "u_PosRange"), INSTANCE_POS_RANGE);
+    glUniform1f(glGetUniformLocation(shaderProgram, "u_SizeRange"), INSTANCE_SIZE_RANGE);
+
+    unsigned int instanceVBO;
+    glGenBuffers(1, &instanceVBO);
 
-    float quad_vertices[] = {-0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f};
     unsigned int quad_indices[] = {0, 1, 2, 2, 3, 0};
     unsigned int quadVAO, quadVBO, quadEBO;
     glGenVertexArrays(1, &quadVAO); glGenBuffers(1, &quadVBO); glGenBuffers(1, &quadEBO);
@@ -380,86 +565,135 @@ int main() {
     glBindBuffer(GL_ARRAY_BUFFER, quadVBO); glBufferData(GL_ARRAY_BUFFER, sizeof(quad_vertices), quad_vertices, GL_STATIC_DRAW);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO); glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(quad_indices), quad_indices, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0); glEnableVertexAttribArray(0);
+    setup_instance_attribs(instanceVBO);
     
-    float player_vertices[] = {0.0f, 0.5f, -0.5f, -0.5f, 0.5f, -0.5f};
     unsigned int playerVAO, playerVBO;
     glGenVertexArrays(1, &playerVAO); glGenBuffers(1, &playerVBO);
     glBindVertexArray(playerVAO);
     glBindBuffer(GL_ARRAY_BUFFER, playerVBO); glBufferData(GL_ARRAY_BUFFER, sizeof(player_vertices), player_vertices, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0); glEnableVertexAttribArray(0);
-
-    srand(time(NULL));
-    load_leaderboard();
-    atexit(print_full_leaderboard);
-    initialize_game();
-    double lastFrame = 0.0;
+    setup_instance_attribs(instanceVBO);
+
+    for (int i = 1; i + 1 < argc; i++) if (strcmp(argv[i], "--seed") == 0) { forced_seed = (uint32_t)strtoul(argv[i + 1], NULL, 10); seed_forced = 1; }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bot") != 0) continue;
+        autopilot_on = 1;
+        if (i + 1 < argc && argv[i + 1][0] != '-') {
+            autopilot_skill = bot_skill_parse(argv[i + 1]);
+            if (autopilot_skill < 0) { fprintf(stderr, "Nepoznat nivo bota: %s\n", argv[i + 1]); return 1; }
+        }
+    }
+    for (int i = 1; i + 1 < argc; i++) if (strcmp(argv[i], "--record") == 0) record_dir = argv[i + 1];
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--replay") != 0) continue;
+        if (!replay_open(&replay, argv[i + 1])) { fprintf(stderr, "Ne mogu da otvorim snimak %s (ili je iz drugog build-a)\n", argv[i + 1]); return 1; }
+        replay_mode = 1;
+        record_dir = NULL;
+        autopilot_on = 0;
+        printf("Snimak %s: seme %u, %u koraka, %.1f s, %u kljucnih frejmova\n", argv[i + 1], replay.header.seed, replay.tick_count, replay.total_time, replay.keyframe_count);
+        fflush(stdout);
+    }
+    // Pregled snimka ne pravi telemetriju ni snimke
+    if (!replay_mode) {
+        telemetry_start();
+        atexit(finish_telemetry);
+        atexit(finish_recording);
+    }
+#ifdef PROFILE
+    TRACE_THREAD("main");
+    for (int i = 1; i < argc; i++) if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) { trace_path = argv[i + 1]; atexit(dump_trace); }
+#endif
+    // Sva privremena memorija frejma dolazi iz jedne arene alocirane ovde
+    if (!arena_init(&frame_arena, FRAME_ARENA_SIZE)) { fprintf(stderr, "Nema memorije za frame arenu\n"); return 1; }
+    thread_arena = &frame_arena;
+    atexit(report_frame_arena);
+    atexit(report_collisions);
+    if (replay_mode) replay_jump(0); else start_new_game();
+    double lastFrame = glfwGetTime();
+    int first_frame = 1;
 
     while (!glfwWindowShouldClose(window)) {
+        TRACE_ZONE("frame");
+        arena_reset(&frame_arena);
         double currentFrame = glfwGetTime();
         double deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
         processInput(window, deltaTime);
-        update_state(window, deltaTime);
-        glClearColor(0.05f, 0.05f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        glUseProgram(shaderProgram);
-        int translateLoc = glGetUniformLocation(shaderProgram, "u_Translate");
-        int scaleLoc = glGetUniformLocation(shaderProgram, "u_Scale");
-        int rotationLoc = glGetUniformLocation(shaderProgram, "u_Rotation");
-        int colorLoc = glGetUniformLocation(shaderProgram, "u_Color");
-        
-        glBindVertexArray(quadVAO);
-        for (int i = 0; i < MAX_STARS; i++) {
-            float size, brightness;
-            if (stars[i].layer == 0) { size = 0.005f; brightness = 0.3f; }
-            else if (stars[i].layer == 1) { size = 0.008f; brightness = 0.6f; }
-            else { size = 0.012f; brightness = 1.0f; }
-            glUniform2f(translateLoc, stars[i].position.x, stars[i].position.y);
-            glUniform2f(scaleLoc, size, size);
-            glUniform1f(rotationLoc, 0.0f);
-            glUniform3f(colorLoc, brightness, brightness, brightness);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        double t_input = glfwGetTime();
+        // Snimak dobija stanje pre koraka i ulaz koji se primenjuje; pregled snimka sam pomera igru
+        if (!game.game_over && !replay_mode) {
+            frame_stats_add(&run_frames, deltaTime);
+            if (recorder.file != NULL) replay_writer_tick(&recorder, &game, &frame_input, deltaTime);
+            apply_input(&game, &frame_input, deltaTime);
         }
-        
-        if (!game_over) {
-            for (int i = 0; i < MAX_ASTEROIDS; i++) if (asteroids[i].active) {
-                glUniform2f(translateLoc, asteroids[i].position.x, asteroids[i].position.y);
-                glUniform2f(scaleLoc, asteroids[i].size.x, asteroids[i].size.y);
-                glUniform1f(rotationLoc, asteroids[i].rotation);
-                glUniform3f(colorLoc, asteroids[i].color.r, asteroids[i].color.g, asteroids[i].color.b);
-                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-            }
-            for (int i = 0; i < MAX_BULLETS; i++) if (bullets[i].active) {
-                glUniform2f(translateLoc, bullets[i].position.x, bullets[i].position.y);
-                glUniform2f(scaleLoc, bullets[i].size.x, bullets[i].size.y);
-                glUniform1f(rotationLoc, bullets[i].rotation);
-                glUniform3f(colorLoc, bullets[i].color.r, bullets[i].color.g, bullets[i].color.b);
-                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-            }
+        if (!replay_mode && update_state(&game, deltaTime)) record_game_over();
+        poll_server_rank();
+        update_title(window);
+        double t_update = glfwGetTime();
+        {
+            TRACE_ZONE("draw/clear");
+            glClearColor(0.05f, 0.05f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glUseProgram(shaderProgram);
+        }
+
+        RenderSnapshot snapshot;
+        {
+            TRACE_ZONE("draw/snapshot_build");
+            render_snapshot_build(&snapshot, &game, &frame_arena);
         }
-        
-        if (player.active) {
-            glBindVertexArray(playerVAO);
-            glUniform2f(translateLoc, player.position.x, player.position.y);
-            glUniform2f(scaleLoc, player.size.x, player.size.y);
-            glUniform1f(rotationLoc, player.rotation);
-            glUniform3f(colorLoc, player.color.r, player.color.g, player.color.b);
-            glDrawArrays(GL_TRIANGLES, 0, 3);
+        {
+            TRACE_ZONE("draw/world");
+            draw_batch(quadVAO, instanceVBO, &snapshot.quads, 6, 1);
+            draw_batch(playerVAO, instanceVBO, &snapshot.player, 3, 0);
         }
 
-        if (game_over) {
-            game_over_animation_timer += deltaTime * 1.5;
-            float anim_progress = fmin(1.0, game_over_animation_timer);
-            glBindVertexArray(quadVAO);
-            draw_game_over_screen(translateLoc, scaleLoc, rotationLoc, colorLoc, anim_progress);
+        if (game.game_over) {
+            TRACE_ZONE("draw/game_over");
+            game.game_over_animation_timer += deltaTime * 1.5;
+            float anim_progress = fmin(1.0, game.game_over_animation_timer);
+            InstanceBatch ui;
+            batch_init(&ui, &frame_arena, UI_BATCH_CAPACITY);
+            draw_game_over_screen(&ui, anim_progress);
+            draw_batch(quadVAO, instanceVBO, &ui, 6, 1);
+        }
+        if (replay_mode) {
+            InstanceBatch bar;
+            batch_init(&bar, &frame_arena, 2);
+            draw_replay_bar(&bar);
+            draw_batch(quadVAO, instanceVBO, &bar, 6, 1);
+        }
+        if (show_perf) {
+            TRACE_ZONE("draw/perf_overlay");
+            InstanceBatch overlay;
+            batch_init(&overlay, &frame_arena, UI_BATCH_CAPACITY);
+            draw_perf_overlay(&overlay, t_update);
+            draw_batch(quadVAO, instanceVBO, &overlay, 6, 1);
         }
 
-        glfwSwapBuffers(window);
+        double t_render = glfwGetTime();
+        {
+            TRACE_ZONE("glfwSwapBuffers");
+            glfwSwapBuffers(window);
+        }
+        double t_swap = glfwGetTime();
+        gl_instrument_frame_end();
+        frame_ring_push(&frame_ring, (float[PHASE_COUNT]){ (float)((t_input - currentFrame) * 1000.0), (float)((t_update - t_input) * 1000.0),
+                                                           (float)((t_render - t_update) * 1000.0), (float)((t_swap - t_render) * 1000.0) });
+        if (first_frame) {
+            struct timespec now; timespec_get(&now, TIME_UTC);
+            printf("Prvi frejm posle %.1f ms (leaderboard: %s)\n", (now.tv_sec - start.tv_sec) * 1e3 + (now.tv_nsec - start.tv_nsec) / 1e6,
+                   loader_done(&leaderboard_task) ? "ucitan" : "jos se ucitava");
+            if (loader_done(&leaderboard_task)) printf("Ucitavanje leaderboard-a: %.1f ms\n", leaderboard_task.seconds * 1000.0);
+            fflush(stdout);
+            first_frame = 0;
+        }
         glfwPollEvents();
     }
     
     glDeleteVertexArrays(1, &quadVAO); glDeleteBuffers(1, &quadVBO); glDeleteBuffers(1, &quadEBO);
     glDeleteVertexArrays(1, &playerVAO); glDeleteBuffers(1, &playerVBO);
+    glDeleteBuffers(1, &instanceVBO);
     glDeleteProgram(shaderProgram);
     glfwTerminate();
     
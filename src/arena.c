@@ -0,0 +1,56 @@
+#include "arena.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+Arena frame_arena;
+_Thread_local Arena* thread_arena = NULL;
+
+int arena_init(Arena* a, size_t capacity) {
+    *a = (Arena){0};
+    a->base = malloc(capacity);
+    if (a->base == NULL) return 0;
+    a->capacity = capacity;
+    return 1;
+}
+
+void* arena_alloc(Arena* a, size_t size) {
+    size_t start = (a->used + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1);
+    if (start > a->capacity || size > a->capacity - start) { a->failed++; return NULL; }
+    a->used = start + size;
+    if (a->used > a->high_water) a->high_water = a->used;
+    return a->base + start;
+}
+
+void arena_reset(Arena* a) { a->used = 0; }
+
+void arena_destroy(Arena* a) { free(a->base); *a = (Arena){0}; }
+
+void* scratch_alloc(size_t size) {
+    void* p = thread_arena != NULL ? arena_alloc(thread_arena, size) : NULL;
+    return p != NULL ? p : malloc(size);
+}
+
+void scratch_free(void* p) {
+    Arena* a = thread_arena;
+    if (a != NULL && (unsigned char*)p >= a->base && (unsigned char*)p < a->base + a->capacity) return;
+    free(p);
+}
+
+char* arena_printf(Arena* a, const char* fmt, ...) {
+    va_list args, copy;
+    va_start(args, fmt);
+    va_copy(copy, args);
+    int len = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    char* out = (len >= 0) ? arena_alloc(a, (size_t)len + 1) : NULL;
+    if (out != NULL) vsnprintf(out, (size_t)len + 1, fmt, args);
+    va_end(args);
+    return out;
+}
+
+void arena_report(const char* name, const Arena* a) {
+    printf("%s: high-water %zu / %zu bajtova, neuspelih alokacija: %zu\n", name, a->high_water, a->capacity, a->failed);
+    fflush(stdout);
+}
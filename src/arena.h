@@ -0,0 +1,45 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// --- Frame arena ---
+// Linearni ("bump") alokator za privremene podatke jednog frejma.
+// Memorija se rezervise jednom pri startu, a arena_reset na vrhu glavne
+// petlje "oslobadja" sve odjednom, pa ustaljen frejm nema nijedan malloc/free.
+typedef struct Arena {
+    unsigned char* base;
+    size_t capacity;
+    size_t used;
+    size_t high_water;   // najveca iskoriscenost ikad (za podesavanje kapaciteta)
+    size_t failed;       // broj zahteva koji nisu stali u arenu
+} Arena;
+
+#define ARENA_ALIGN 16
+#define FRAME_ARENA_SIZE (1u << 20)
+
+int arena_init(Arena* a, size_t capacity);
+void* arena_alloc(Arena* a, size_t size);
+void arena_reset(Arena* a);
+char* arena_printf(Arena* a, const char* fmt, ...);
+void arena_report(const char* name, const Arena* a);
+
+#define ARENA_NEW(a, T, n) ((T*)arena_alloc((a), sizeof(T) * (size_t)(n)))
+
+extern Arena frame_arena;
+
+// --- Arene niti ---
+// Svaka nit sa svojom arenom postavlja thread_arena (frejm nit frame_arena,
+// loader nit svoju), pa kod koji radi na vise niti nikad ne deli arenu sa
+// drugom niti. Vlasnik arene bira tacku povratka: frejm nit vrh petlje, loader
+// kraj svakog zadatka (arena_mark / arena_rewind).
+extern _Thread_local Arena* thread_arena;
+static inline size_t arena_mark(const Arena* a) { return a->used; }
+static inline void arena_rewind(Arena* a, size_t mark) { if (mark < a->used) a->used = mark; }
+void arena_destroy(Arena* a);
+// Privremen blok iz thread_arena, ili malloc ako nit nema arenu ili arena nema mesta;
+// scratch_free oslobadja samo malloc blokove (arenu vraca njen vlasnik)
+void* scratch_alloc(size_t size);
+void scratch_free(void* p);
+
+#endif
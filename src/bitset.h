@@ -0,0 +1,37 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdint.h>
+
+// --- Bitset zivih objekata ---
+// Jedan bit po slotu u 64-bitnim recima. Iteracija preko zivih slotova ide
+// preko count-trailing-zeros, pa prazni delovi bazena kostaju jednu rec,
+// a "obrisi sve", "ima li ikog" i brojanje su po nekoliko operacija nad recima.
+#define BITSET_WORDS(nbits) (((nbits) + 63) / 64)
+
+static inline void bitset_set(uint64_t* w, int i) { w[i >> 6] |= (uint64_t)1 << (i & 63); }
+static inline void bitset_clear(uint64_t* w, int i) { w[i >> 6] &= ~((uint64_t)1 << (i & 63)); }
+static inline int bitset_test(const uint64_t* w, int i) { return (int)((w[i >> 6] >> (i & 63)) & 1); }
+
+static inline void bitset_clear_all(uint64_t* w, int nwords) { for (int k = 0; k < nwords; k++) w[k] = 0; }
+static inline int bitset_any(const uint64_t* w, int nwords) { uint64_t acc = 0; for (int k = 0; k < nwords; k++) acc |= w[k]; return acc != 0; }
+static inline int bitset_count(const uint64_t* w, int nwords) { int c = 0; for (int k = 0; k < nwords; k++) c += __builtin_popcountll(w[k]); return c; }
+
+// Prvi slobodan slot medju nbits, ili -1 ako je bazen pun
+static inline int bitset_first_clear(const uint64_t* w, int nbits) {
+    for (int k = 0; k < BITSET_WORDS(nbits); k++) {
+        uint64_t free_bits = ~w[k];
+        if (free_bits) { int i = k * 64 + __builtin_ctzll(free_bits); return i < nbits ? i : -1; }
+    }
+    return -1;
+}
+
+// for-petlja preko indeksa postavljenih bitova. Rec se kopira pre obilaska,
+// pa brisanje tekuceg bita u telu petlje je bezbedno. `break` iz tela izlazi
+// samo iz unutrasnje petlje - za rani izlaz koristiti zastavicu.
+#define BITSET_FOR_EACH(words, nwords, i) \
+    for (int i##_w = 0; i##_w < (nwords); i##_w++) \
+        for (uint64_t i##_bits = (words)[i##_w]; i##_bits; i##_bits &= i##_bits - 1) \
+            for (int i = i##_w * 64 + __builtin_ctzll(i##_bits), i##_once = 1; i##_once; i##_once = 0)
+
+#endif
@@ -0,0 +1,152 @@
+#include "bot.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "collision.h"
+
+#define BOT_THREATS 32        // razmatraju se samo asteroidi koji najpre stizu
+#define BOT_CANDIDATES 41     // polozaji na x osi za izmicanje (korak 0.05)
+#define BOT_PATH_STEPS 8
+
+typedef struct { float reaction, lookahead, aim_tolerance, aim_noise; } BotParams;
+static const BotParams skill_params[BOT_SKILL_COUNT] = {
+    [BOT_EASY]   = { 0.35f, 0.35f, 0.05f, 0.08f },
+    [BOT_NORMAL] = { 0.15f, 0.70f, 0.03f, 0.03f },
+    [BOT_EXPERT] = { 0.00f, 0.90f, 0.02f, 0.00f },
+};
+static const char* skill_names[BOT_SKILL_COUNT] = { "easy", "normal", "expert" };
+
+// Asteroid je opasan za kolonu |x - ax| < lane od arrive do leave sekundi
+typedef struct { float x, lane, arrive, leave; int index, target; } Threat;
+
+static uint32_t bot_rand(Bot* b) {
+    b->rng ^= b->rng >> 12; b->rng ^= b->rng << 25; b->rng ^= b->rng >> 27;
+    return (uint32_t)((b->rng * 0x2545F4914F6CDD1DULL) >> 33);
+}
+
+const char* bot_skill_name(BotSkill skill) { return skill >= 0 && skill < BOT_SKILL_COUNT ? skill_names[skill] : "?"; }
+
+int bot_skill_parse(const char* name) {
+    for (int i = 0; i < BOT_SKILL_COUNT; i++) if (strcmp(name, skill_names[i]) == 0) return i;
+    char* end;
+    long v = strtol(name, &end, 10);
+    return (*end == '\0' && end != name && v >= 0 && v < BOT_SKILL_COUNT) ? (int)v : -1;
+}
+
+void bot_init(Bot* b, BotSkill skill, uint32_t seed) {
+    memset(b, 0, sizeof(*b));
+    b->skill = skill;
+    const BotParams* p = &skill_params[skill];
+    b->reaction = p->reaction; b->lookahead = p->lookahead; b->aim_tolerance = p->aim_tolerance; b->aim_noise = p->aim_noise;
+    b->rng = 0xD1B54A32D192ED03ULL ^ seed;
+    b->target_index = -1;
+}
+
+// Da li vec leti metak koji ce pogoditi asteroid (ista kolona, ispod njega)
+static int bullet_covers(const GameState* g, const GameObject* a) {
+    float half = 0.5f * a->size.x + 0.01f;
+    FOR_EACH_BULLET(g, i) {
+        const GameObject* b = &g->bullets[i];
+        if (b->position.y < a->position.y && b->position.x > a->position.x - half && b->position.x < a->position.x + half) return 1;
+    }
+    return 0;
+}
+
+// Polozaj je opasan ako ga pretnja zatekne tamo dok prolazi visinu igraca;
+// put do polozaja se proverava u BOT_PATH_STEPS tacaka
+static float position_danger(const Threat* t, int n, float from, float to, float speed, float lookahead) {
+    float danger = 0.0f, travel = fabsf(to - from) / speed;
+    for (int k = 0; k < n; k++) {
+        if (t[k].target || t[k].arrive > lookahead) continue;
+        for (int s = 0; s <= BOT_PATH_STEPS; s++) {
+            float f = (float)s / BOT_PATH_STEPS, x = from + (to - from) * f, at = travel * f;
+            // Na cilju igrac ostaje do kraja predvidjanja
+            int there = (s == BOT_PATH_STEPS) ? t[k].leave >= at : (at >= t[k].arrive - 0.05f && at <= t[k].leave);
+            if (there && fabsf(t[k].x - x) < t[k].lane) { danger += 1.0f + (lookahead - t[k].arrive); break; }
+        }
+    }
+    return danger;
+}
+
+static void decide(Bot* b, const GameState* g) {
+    const GameObject* p = &g->player;
+    float px = p->position.x, py = p->position.y, speed = p->velocity.x;
+    float player_half = 0.5f * p->size.x;
+    Threat threats[BOT_THREATS];
+    int n = 0, best = -1;
+    float best_deadline = 1e9f;
+
+    FOR_EACH_ASTEROID(g, i) {
+        const GameObject* a = &g->asteroids[i];
+        float vy = a->velocity.y < -0.01f ? -a->velocity.y : 0.01f;
+        float above = a->position.y - py;
+        if (above < -0.1f) continue;                       // vec prosao igraca
+        float lane = player_half + bounding_radius(a->size) + 0.01f;
+        float reach = bounding_radius(a->size) + 0.5f * p->size.y;
+        float arrive = (above - reach) / vy, leave = (above + reach) / vy;   // prolazak kroz visinu igraca
+        if (arrive < 0.0f) arrive = 0.0f;
+        int covered = bullet_covers(g, a);
+
+        // Meta: najraniji rok koji se jos stize (pomeranje + cekanje + let metka)
+        float deadline = above / vy;
+        float need = fabsf(a->position.x - px) / speed + (float)(g->shoot_cooldown > 0.0 ? g->shoot_cooldown : 0.0) + above / (BULLET_SPEED + vy);
+        int feasible = !covered && above > 0.05f && a->position.y < 1.05f && need < deadline;
+        if (feasible && i == b->target_index) deadline -= 0.15f;   // ne menjati metu zbog sitne razlike
+        if (feasible && deadline < best_deadline) { best_deadline = deadline; best = i; }
+
+        if (covered && arrive > above / (BULLET_SPEED + vy)) continue;   // metak stize pre njega
+        // Zadrzava se BOT_THREATS pretnji koje najranije stizu
+        Threat t = { a->position.x, lane, arrive, leave, i, 0 };
+        if (n < BOT_THREATS) threats[n++] = t;
+        else {
+            int worst = 0;
+            for (int k = 1; k < n; k++) if (threats[k].arrive > threats[worst].arrive) worst = k;
+            if (arrive < threats[worst].arrive) threats[worst] = t;
+        }
+    }
+
+    float desired = px;
+    b->has_target = best >= 0;
+    if (b->has_target) {
+        const GameObject* a = &g->asteroids[best];
+        desired = a->position.x + b->aim_offset;
+        // Meta koja ce biti oborena pre nego sto stigne ne blokira sopstvenu kolonu
+        float vy = -a->velocity.y, above = a->position.y - py;
+        float shot = fabsf(desired - px) / speed + (float)(g->shoot_cooldown > 0.0 ? g->shoot_cooldown : 0.0) + above / (BULLET_SPEED + vy);
+        for (int k = 0; k < n; k++) if (threats[k].index == best && shot < threats[k].arrive - 0.05f) threats[k].target = 1;
+    }
+    if (desired > 1.0f) desired = 1.0f;
+    if (desired < -1.0f) desired = -1.0f;
+
+    float best_cost = position_danger(threats, n, px, desired, speed, b->lookahead) * 10.0f;
+    float chosen = desired;
+    if (best_cost > 0.0f) {
+        for (int c = 0; c < BOT_CANDIDATES; c++) {
+            float x = -1.0f + 2.0f * c / (BOT_CANDIDATES - 1);
+            float cost = position_danger(threats, n, px, x, speed, b->lookahead) * 10.0f + fabsf(x - desired);
+            if (cost < best_cost) { best_cost = cost; chosen = x; }
+        }
+        if (chosen != desired) b->has_target = 0;   // izmice se; puca samo ako se usput poravna
+    }
+    b->target_x = chosen;
+    b->target_index = best;
+}
+
+void bot_think(Bot* b, const GameState* g, double dt, GameInput* out) {
+    *out = (GameInput){ 0 };
+    if (g->game_over) return;
+    b->think_timer -= dt;
+    if (b->think_timer <= 0.0) {
+        if (b->aim_noise > 0.0f) b->aim_offset = ((bot_rand(b) % 2001) / 1000.0f - 1.0f) * b->aim_noise;
+        decide(b, g);
+        b->think_timer += b->reaction;
+        if (b->think_timer < 0.0) b->think_timer = 0.0;
+    }
+    float dx = b->target_x - g->player.position.x;
+    float step = g->player.velocity.x * (float)dt;
+    // Ne preletati cilj: stani kad je ostatak manji od jednog koraka
+    out->left = dx < -0.5f * step;
+    out->right = dx > 0.5f * step;
+    out->shoot = b->has_target && fabsf(dx) < b->aim_tolerance;
+}
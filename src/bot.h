@@ -0,0 +1,33 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include <stdint.h>
+
+#include "game.h"
+
+// --- Autopilot ---
+// Bot puni isti GameInput kao tastatura. Na svakih `reaction` sekundi bira
+// metu: asteroid sa najranijim rokom (pre nego sto prodje igraca) koji jos
+// stize da obori i na koji vec ne leti metak. Zatim trazi najblizi polozaj
+// na x osi koji je bezbedan za `lookahead` sekundi, racunajuci i put do njega,
+// pa se izmice kad je meta nedostizna. Puca kad je poravnat sa metom.
+// Nivoi se razlikuju po reakciji, predvidjanju i gresci nisanjenja. Bot ima
+// svoj generator, pa ne menja niz game_rand i igra ostaje ponovljiva iz semena.
+typedef enum { BOT_EASY, BOT_NORMAL, BOT_EXPERT, BOT_SKILL_COUNT } BotSkill;
+
+typedef struct {
+    BotSkill skill;
+    float reaction, lookahead, aim_tolerance, aim_noise;   // iz tabele nivoa
+    double think_timer;
+    float target_x, aim_offset;
+    int has_target, target_index;
+    uint64_t rng;
+} Bot;
+
+void bot_init(Bot* b, BotSkill skill, uint32_t seed);
+void bot_think(Bot* b, const GameState* g, double dt, GameInput* out);
+const char* bot_skill_name(BotSkill skill);
+// "easy"/"normal"/"expert" ili broj; -1 ako ime nije poznato
+int bot_skill_parse(const char* name);
+
+#endif
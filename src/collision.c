@@ -0,0 +1,107 @@
+#include "collision.h"
+
+#include <stdio.h>
+
+// Prenosivi SIMD preko vektorskih prosirenja kompajlera (clang i gcc,
+// x86 i ARM): 4 ose se obradjuju odjednom, po jedna u svakoj traci.
+typedef float f32x4 __attribute__((vector_size(16)));
+typedef int i32x4 __attribute__((vector_size(16)));
+
+static inline f32x4 v4_splat(float s) { return (f32x4){s, s, s, s}; }
+static inline f32x4 v4_min(f32x4 a, f32x4 b) { i32x4 m = a < b; return (f32x4)(((i32x4)a & m) | ((i32x4)b & ~m)); }
+static inline f32x4 v4_max(f32x4 a, f32x4 b) { i32x4 m = a > b; return (f32x4)(((i32x4)a & m) | ((i32x4)b & ~m)); }
+
+void poly_from_shape(ConvexPoly* p, const float* verts, int n, Vec2 pos, Vec2 size, float rotation) {
+    float c = cosf(rotation), s = sinf(rotation);
+    p->n = n;
+    for (int i = 0; i < n; i++) {
+        float vx = verts[i * 2], vy = verts[i * 2 + 1];
+        p->x[i] = (c * vx + s * vy) * size.x + pos.x;
+        p->y[i] = (-s * vx + c * vy) * size.y + pos.y;
+    }
+}
+
+int poly_edge_axes(const ConvexPoly* p, Vec2* axes) {
+    for (int i = 0; i < p->n; i++) {
+        int j = (i + 1) % p->n;
+        axes[i] = (Vec2){-(p->y[j] - p->y[i]), p->x[j] - p->x[i]};
+    }
+    return p->n;
+}
+
+// Projekcija svih temena na 4 ose odjednom: min/max po trakama
+static void project4(const ConvexPoly* p, f32x4 ax, f32x4 ay, f32x4* lo, f32x4* hi) {
+    f32x4 d = v4_splat(p->x[0]) * ax + v4_splat(p->y[0]) * ay;
+    f32x4 mn = d, mx = d;
+    for (int i = 1; i < p->n; i++) {
+        d = v4_splat(p->x[i]) * ax + v4_splat(p->y[i]) * ay;
+        mn = v4_min(mn, d); mx = v4_max(mx, d);
+    }
+    *lo = mn; *hi = mx;
+}
+
+int sat_overlap(const ConvexPoly* a, const ConvexPoly* b, const Vec2* axes, int num_axes) {
+    for (int base = 0; base < num_axes; base += 4) {
+        f32x4 ax, ay;
+        for (int k = 0; k < 4; k++) {
+            // Visak traka popunjava poslednja osa (duplikat ne menja ishod)
+            int idx = (base + k < num_axes) ? base + k : num_axes - 1;
+            ax[k] = axes[idx].x; ay[k] = axes[idx].y;
+        }
+        f32x4 alo, ahi, blo, bhi;
+        project4(a, ax, ay, &alo, &ahi);
+        project4(b, ax, ay, &blo, &bhi);
+        i32x4 sep = (ahi < blo) | (bhi < alo);
+        if (sep[0] | sep[1] | sep[2] | sep[3]) return 0;
+    }
+    return 1;
+}
+
+int asteroid_hits_player_swept(const GameObject* asteroid, const GameObject* player) {
+    ConvexPoly p, start, end, sweep; Vec2 axes[POLY_MAX_AXES];
+    poly_from_shape(&p, player_vertices, 3, player->position, player->size, player->rotation);
+    // Polozaj asteroida u odnosu na igraca na pocetku i kraju koraka
+    Vec2 rel0 = {asteroid->prev_position.x - player->prev_position.x + player->position.x,
+                 asteroid->prev_position.y - player->prev_position.y + player->position.y};
+    poly_from_shape(&start, quad_vertices, 4, rel0, asteroid->size, asteroid->rotation);
+    poly_from_shape(&end, quad_vertices, 4, asteroid->position, asteroid->size, asteroid->rotation);
+    sweep.n = 8;
+    for (int i = 0; i < 4; i++) {
+        sweep.x[i] = start.x[i]; sweep.y[i] = start.y[i];
+        sweep.x[i + 4] = end.x[i]; sweep.y[i + 4] = end.y[i];
+    }
+    // Kvadrat ima samo 2 razlicite ose, trougao 3, plus normala pravca kretanja
+    int n = poly_edge_axes(&end, axes) - 2;
+    n += poly_edge_axes(&p, axes + n);
+    Vec2 d = {asteroid->position.x - rel0.x, asteroid->position.y - rel0.y};
+    if (d.x != 0.0f || d.y != 0.0f) axes[n++] = (Vec2){-d.y, d.x};
+    return sat_overlap(&p, &sweep, axes, n);
+}
+
+int asteroid_hits_bullet_swept(const GameObject* asteroid, const GameObject* bullet) {
+    ConvexPoly a, start, end, sweep; Vec2 axes[POLY_MAX_AXES];
+    poly_from_shape(&a, quad_vertices, 4, asteroid->position, asteroid->size, asteroid->rotation);
+    // Polozaj metka u odnosu na asteroid na pocetku i kraju koraka
+    Vec2 rel0 = {bullet->prev_position.x - asteroid->prev_position.x + asteroid->position.x,
+                 bullet->prev_position.y - asteroid->prev_position.y + asteroid->position.y};
+    poly_from_shape(&start, quad_vertices, 4, rel0, bullet->size, bullet->rotation);
+    poly_from_shape(&end, quad_vertices, 4, bullet->position, bullet->size, bullet->rotation);
+    // Omotac oba polozaja: projekcija je unija projekcija, pa su dovoljna sva temena
+    sweep.n = 8;
+    for (int i = 0; i < 4; i++) {
+        sweep.x[i] = start.x[i]; sweep.y[i] = start.y[i];
+        sweep.x[i + 4] = end.x[i]; sweep.y[i + 4] = end.y[i];
+    }
+    int n = poly_edge_axes(&a, axes) - 2;
+    n += poly_edge_axes(&end, axes + n) - 2;
+    Vec2 d = {bullet->position.x - rel0.x, bullet->position.y - rel0.y};
+    if (d.x != 0.0f || d.y != 0.0f) axes[n++] = (Vec2){-d.y, d.x};
+    return sat_overlap(&a, &sweep, axes, n);
+}
+
+void collision_stats_print(const CollisionStats* s) {
+    double pairs = s->pairs ? (double)s->pairs : 1.0;
+    printf("Sudari: %llu parova, krug odbacio %.1f%%, SAT odbacio %.1f%%, pogodaka %llu\n",
+           s->pairs, 100.0 * s->circle_rejects / pairs, 100.0 * s->sat_rejects / pairs, s->hits);
+    fflush(stdout);
+}
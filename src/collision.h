@@ -0,0 +1,52 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "game.h"
+
+// --- Kontinualna (swept) detekcija sudara ---
+// Oba tela se krecu pravolinijski tokom koraka, pa je dovoljno posmatrati
+// relativno kretanje: duz p0 -> p1 (pozicija A u odnosu na B na pocetku i
+// kraju koraka) protiv kruga poluprecnika r oko koordinatnog pocetka.
+// Vraca 1 i trenutak prvog dodira t u [0,1] ako se dodiruju tokom koraka.
+static inline int swept_circle_hit(Vec2 p0, Vec2 p1, float r, float* t_hit) {
+    float c = p0.x * p0.x + p0.y * p0.y - r * r;
+    if (c < 0.0f) { *t_hit = 0.0f; return 1; }       // vec se preklapaju
+    float dx = p1.x - p0.x, dy = p1.y - p0.y;
+    float a = dx * dx + dy * dy;
+    float b = p0.x * dx + p0.y * dy;
+    if (a <= 0.0f || b >= 0.0f) return 0;             // ne priblizavaju se
+    float disc = b * b - a * c;
+    if (disc < 0.0f) return 0;
+    float t = (-b - sqrtf(disc)) / a;
+    if (t > 1.0f) return 0;
+    *t_hit = t;
+    return 1;
+}
+
+// Poluprecnik kruga koji sigurno obuhvata oblik (za jeftino odbacivanje)
+static inline float bounding_radius(Vec2 size) { return 0.5f * sqrtf(size.x * size.x + size.y * size.y); }
+
+// --- Tacan test oblika (SAT) ---
+// Konveksni poligon u svetskim koordinatama; 8 temena je dovoljno i za
+// pravougaonik "razvucen" duz putanje metka (pocetni + krajnji polozaj).
+#define POLY_MAX_VERTS 8
+#define POLY_MAX_AXES 8
+typedef struct { float x[POLY_MAX_VERTS], y[POLY_MAX_VERTS]; int n; } ConvexPoly;
+
+// Transformacija identicna vertex sejderu: rotacija, pa skaliranje, pa pomeraj
+void poly_from_shape(ConvexPoly* p, const float* verts, int n, Vec2 pos, Vec2 size, float rotation);
+// Normale ivica poligona (nenormalizovane); vraca broj osa
+int poly_edge_axes(const ConvexPoly* p, Vec2* axes);
+// 1 ako se projekcije preklapaju na svim osama (nema razdvajajuce ose)
+int sat_overlap(const ConvexPoly* a, const ConvexPoly* b, const Vec2* axes, int num_axes);
+
+// Asteroid (rotirani kvadrat) prebrisan od prethodnog do trenutnog polozaja
+// protiv igraca (trougao), u koordinatama igraca; dugacak korak ne preskace igraca
+int asteroid_hits_player_swept(const GameObject* asteroid, const GameObject* player);
+// Asteroid protiv pravougaonika metka prebrisanog od prethodnog do trenutnog
+// polozaja, u koordinatama asteroida (tacno za pravolinijsko kretanje)
+int asteroid_hits_bullet_swept(const GameObject* asteroid, const GameObject* bullet);
+
+void collision_stats_print(const CollisionStats* s);
+
+#endif
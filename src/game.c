@@ -0,0 +1,189 @@
+#include "game.h"
+#include "collision.h"
+#include "trace.h"
+
+const float quad_vertices[8] = {-0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f};
+const float player_vertices[6] = {0.0f, 0.5f, -0.5f, -0.5f, 0.5f, -0.5f};
+
+// --- Inicijalizacija igre ---
+void initialize_game(GameState* g, uint32_t seed) {
+    // Reset globalnog stanja
+    g->seed = seed;
+    g->rng = 0x9E3779B97F4A7C15ULL ^ seed;   // xorshift stanje nikad ne sme biti 0
+    g->star_rng = 0xBF58476D1CE4E5B9ULL ^ seed;
+    g->score = 0;
+    g->game_over = 0;
+    g->asteroid_spawn_timer = 0.0;
+    g->shoot_cooldown = 0.0;
+    g->asteroids_missed = 0;
+    g->game_over_animation_timer = 0.0;
+    g->run_time = 0.0;
+    g->shots_fired = 0;
+    g->asteroids_destroyed = 0;
+
+    // Igrac
+    g->player.position = (Vec2){0.0f, -0.8f};
+    g->player.prev_position = g->player.position;
+    g->player.size = (Vec2){0.12f, 0.12f};
+    g->player.velocity = (Vec2){1.5f, 0.0f};
+    g->player.color = (Vec3){0.2f, 0.8f, 1.0f};
+    g->player.rotation = 0.0f;
+    g->player_active = 1;
+
+    // Metci i asteroidi
+    bitset_clear_all(g->bullet_live, BULLET_WORDS);
+    bitset_clear_all(g->asteroid_live, ASTEROID_WORDS);
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        g->bullets[i].rotation = 0.0f;
+        g->bullets[i].size = (Vec2){0.02f, 0.05f};
+        g->bullets[i].color = (Vec3){1.0f, 1.0f, 0.0f};
+    }
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        g->asteroids[i].rotation = 0.0f;
+        g->asteroids[i].size = (Vec2){0.1f, 0.1f};
+        // Inicijalne vrednosti za ciklus boje; konkretna boja se postavlja pri spawnu
+        g->asteroid_hue[i] = (game_rand(g) % 1000) / 1000.0f;
+        g->asteroid_hue_speed[i] = 0.15f + ((game_rand(g) % 200) / 1000.0f); // 0.15..0.35
+        g->asteroids[i].color = hsv_to_rgb(g->asteroid_hue[i], 0.85f, 0.95f);
+    }
+
+    // Zvezde (paralaksa)
+    for (int i = 0; i < MAX_STARS; i++) {
+        g->stars.x[i] = ((star_rand(g) % 2000) / 1000.0f) - 1.0f;
+        g->stars.y[i] = ((star_rand(g) % 2000) / 1000.0f) - 1.0f;
+        g->stars.layer[i] = (uint8_t)(star_rand(g) % NUM_LAYERS);
+        float base = 0.15f;
+        if (g->stars.layer[i] == 0) g->stars.speed[i] = base * 0.6f;
+        else if (g->stars.layer[i] == 1) g->stars.speed[i] = base * 1.0f;
+        else g->stars.speed[i] = base * 1.5f;
+    }
+}
+
+// --- Funkcije za igru ---
+void shoot_bullet(GameState* g) { int i = bitset_first_clear(g->bullet_live, MAX_BULLETS); if (i < 0) return; g->bullets[i] = (GameObject){g->player.position, {0.02f, 0.05f}, {0.0f, BULLET_SPEED}, {1.0f, 1.0f, 0.0f}, 0.0f, g->player.position}; bitset_set(g->bullet_live, i); g->shots_fired++; }
+void spawn_asteroid(GameState* g) { int i = bitset_first_clear(g->asteroid_live, MAX_ASTEROIDS); if (i < 0) return; float size = ((game_rand(g) % 5) / 100.0f) + 0.08f; g->asteroid_hue[i] = (game_rand(g) % 1000) / 1000.0f; g->asteroid_hue_speed[i] = 0.2f + ((game_rand(g) % 300) / 1000.0f); Vec3 col = hsv_to_rgb(g->asteroid_hue[i], 0.9f, 0.95f); Vec2 pos = {((game_rand(g) % 200) / 100.0f) - 1.0f, 1.1f}; g->asteroids[i] = (GameObject){pos, {size, size}, {0.0f, -(((game_rand(g) % 10) / 100.0f) + 0.2f + (g->score * 0.001f))}, col, 0.0f, pos}; bitset_set(g->asteroid_live, i); }
+
+void apply_input(GameState* g, const GameInput* in, double dt) {
+    if (g->game_over) return;
+    if (in->left) g->player.position.x -= g->player.velocity.x * dt;
+    if (in->right) g->player.position.x += g->player.velocity.x * dt;
+    if (g->player.position.x > 1.0f) g->player.position.x = 1.0f;
+    if (g->player.position.x < -1.0f) g->player.position.x = -1.0f;
+    g->shoot_cooldown -= dt;
+    if (in->shoot && g->shoot_cooldown <= 0.0) {
+        shoot_bullet(g);
+        g->shoot_cooldown = SHOOT_COOLDOWN;
+    }
+}
+
+// Sudari metak-asteroid se racunaju po celoj putanji tokom koraka (swept),
+// pa brz metak ne moze da "preskoci" asteroid ni pri velikom dt.
+// Zato se van ekrana gase tek posle provere sudara.
+// Dve faze: jeftin krug koji obuhvata oba oblika odbacuje skoro sve parove,
+// a tacan SAT test oblika radi se samo za preostale.
+void resolve_bullet_hits(GameState* g) {
+    TRACE_ZONE("update/bullet_hits");
+    CollisionStats* cs = &g->collision_stats;
+    FOR_EACH_BULLET(g, i) {
+        GameObject* b = &g->bullets[i];
+        float rb = bounding_radius(b->size);
+        int hit = -1; float best_t = 2.0f;
+        FOR_EACH_ASTEROID(g, j) {
+            GameObject* a = &g->asteroids[j];
+            float r = rb + bounding_radius(a->size), t;
+            Vec2 p0 = {b->prev_position.x - a->prev_position.x, b->prev_position.y - a->prev_position.y};
+            Vec2 p1 = {b->position.x - a->position.x, b->position.y - a->position.y};
+            cs->pairs++;
+            if (!swept_circle_hit(p0, p1, r, &t)) { cs->circle_rejects++; continue; }
+            if (!asteroid_hits_bullet_swept(a, b)) { cs->sat_rejects++; continue; }
+            if (t < best_t) { best_t = t; hit = j; }
+        }
+        if (hit >= 0) { bitset_clear(g->bullet_live, i); bitset_clear(g->asteroid_live, hit); g->score += 10; g->asteroids_destroyed++; cs->hits++; }
+    }
+}
+
+// --- Glavna logika igre ---
+int update_state(GameState* g, double dt) {
+    TRACE_ZONE("update_state");
+    {
+        TRACE_ZONE("update/stars");
+        // Pomeranje bez grananja (vektorski), pa retki prelomi na vrh u zasebnom prolazu
+        StarField* st = &g->stars;
+        float fdt = (float)dt;
+        for (int i = 0; i < MAX_STARS; i++) st->y[i] -= st->speed[i] * fdt;
+        for (int i = 0; i < MAX_STARS; i++) {
+            if (st->y[i] < -1.1f) {
+                st->y[i] = 1.1f;
+                st->x[i] = ((star_rand(g) % 2000) / 1000.0f) - 1.0f;
+            }
+        }
+    }
+    if (g->game_over) return 0;
+    g->run_time += dt;
+    {
+        TRACE_ZONE("update/bullets");
+        FOR_EACH_BULLET(g, i) {
+            g->bullets[i].prev_position = g->bullets[i].position;
+            g->bullets[i].position.y += g->bullets[i].velocity.y * dt;
+        }
+    }
+    double spawn_interval = 1.0 - (g->score * 0.002);
+    if (spawn_interval < 0.2) spawn_interval = 0.2;
+    g->asteroid_spawn_timer += dt;
+    if (g->asteroid_spawn_timer > spawn_interval) {
+        TRACE_ZONE("update/spawn");
+        spawn_asteroid(g);
+        g->asteroid_spawn_timer = 0.0;
+    }
+    {
+        TRACE_ZONE("update/asteroids");
+        FOR_EACH_ASTEROID(g, i) {
+            g->asteroids[i].prev_position = g->asteroids[i].position;
+            g->asteroids[i].position.y += g->asteroids[i].velocity.y * dt;
+            g->asteroids[i].rotation += 1.0f * dt;
+            // Ažuriraj nijansu za "vibriranje" boje dok asteroid pada
+            g->asteroid_hue[i] += g->asteroid_hue_speed[i] * (float)dt;
+            if (g->asteroid_hue[i] >= 1.0f) g->asteroid_hue[i] -= 1.0f;
+            if (g->asteroid_hue[i] < 0.0f) g->asteroid_hue[i] += 1.0f;
+            g->asteroids[i].color = hsv_to_rgb(g->asteroid_hue[i], 0.9f, 0.95f);
+        }
+    }
+
+    resolve_bullet_hits(g);
+    {
+        TRACE_ZONE("update/cull");
+        FOR_EACH_BULLET(g, i) if (g->bullets[i].position.y > 1.1f) bitset_clear(g->bullet_live, i);
+        FOR_EACH_ASTEROID(g, i) if (g->asteroids[i].position.y < -1.2f) { bitset_clear(g->asteroid_live, i); g->asteroids_missed++; }
+    }
+
+    int should_be_game_over = 0;
+    {
+        TRACE_ZONE("update/player_hit");
+        CollisionStats* cs = &g->collision_stats;
+        float rp = bounding_radius(g->player.size);
+        FOR_EACH_ASTEROID(g, i) {
+            if (should_be_game_over) continue;   // pogodak je vec nadjen
+            const GameObject* a = &g->asteroids[i];
+            float r = rp + bounding_radius(a->size), t;
+            // Kao kod metaka: relativno kretanje tokom koraka, pa tacan test prebrisanog oblika
+            Vec2 p0 = {a->prev_position.x - g->player.prev_position.x, a->prev_position.y - g->player.prev_position.y};
+            Vec2 p1 = {a->position.x - g->player.position.x, a->position.y - g->player.position.y};
+            cs->pairs++;
+            if (!swept_circle_hit(p0, p1, r, &t)) { cs->circle_rejects++; continue; }
+            if (!asteroid_hits_player_swept(a, &g->player)) { cs->sat_rejects++; continue; }
+            cs->hits++;
+            should_be_game_over = 1;
+        }
+    }
+    // Pomeraj igraca sledeceg koraka (apply_input) se meri od ovde
+    g->player.prev_position = g->player.position;
+    if (g->missed_asteroids_rule_enabled && g->asteroids_missed >= MISSED_ASTEROID_LIMIT) {
+        should_be_game_over = 1;
+    }
+    if (should_be_game_over && !g->game_over) {
+        g->game_over = 1;
+        g->player.color.r = 1.0f; g->player.color.g = 0.2f; g->player.color.b = 0.2f;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <math.h>
+#include <stdint.h>
+
+#include "bitset.h"
+
+// --- Definicije ---
+#ifndef MAX_ASTEROIDS
+#define MAX_ASTEROIDS 50
+#endif
+#ifndef MAX_BULLETS
+#define MAX_BULLETS 100
+#endif
+#define MAX_STARS 300
+#define NUM_LAYERS 3
+#define MISSED_ASTEROID_LIMIT 10
+#define SHOOT_COOLDOWN 0.25
+#define BULLET_SPEED 4.0f
+
+// --- Strukture ---
+typedef struct { float x, y; } Vec2;
+typedef struct { float r, g, b; } Vec3;
+// Da li je objekat ziv ne pise se u njemu vec u bitsetu njegovog bazena
+typedef struct { Vec2 position; Vec2 size; Vec2 velocity; Vec3 color; float rotation; Vec2 prev_position; } GameObject;
+// Zvezde kao struktura nizova: pomeranje je jedna petlja nad y i speed koju kompajler vektorizuje
+typedef struct { float x[MAX_STARS], y[MAX_STARS], speed[MAX_STARS]; uint8_t layer[MAX_STARS]; } StarField;
+// Ulaz jednog koraka; puni ga tastatura (processInput), bot ili snimak
+typedef struct { int left, right, shoot; } GameInput;
+// Statistika uske faze sudara: koliko parova je odbacio krug, a koliko SAT
+typedef struct { unsigned long long pairs, circle_rejects, sat_rejects, hits; } CollisionStats;
+
+// Oblici u lokalnim koordinatama (isti podaci idu i u VBO-ove)
+extern const float quad_vertices[8];
+extern const float player_vertices[6];
+
+// Kompletno stanje simulacije; nema nikakve veze sa prozorom ni sa GL-om
+typedef struct GameState {
+    GameObject player;
+    GameObject asteroids[MAX_ASTEROIDS];
+    GameObject bullets[MAX_BULLETS];
+    uint64_t asteroid_live[BITSET_WORDS(MAX_ASTEROIDS)];
+    uint64_t bullet_live[BITSET_WORDS(MAX_BULLETS)];
+    int player_active;
+    StarField stars;
+    // Boja asteroida: ciklus nijanse (HSV) za "vibriranje" boja tokom pada
+    float asteroid_hue[MAX_ASTEROIDS];
+    float asteroid_hue_speed[MAX_ASTEROIDS];
+    int score;
+    int game_over;
+    double asteroid_spawn_timer, shoot_cooldown;
+    int asteroids_missed, missed_asteroids_rule_enabled;
+    double game_over_animation_timer;
+    double run_time;          // trajanje tekuce igre (prezivljavanje), u sekundama
+    int shots_fired, asteroids_destroyed;   // tekuca igra
+    uint32_t seed;            // seme tekuce igre; isto seme daje isti niz asteroida i zvezda
+    uint64_t rng;             // asteroidi
+    uint64_t star_rng;        // zvezde: koliko ih se prelomi zavisi od dt, pa ne smeju trositi rng
+    CollisionStats collision_stats;
+} GameState;
+
+// Sopstveni generator stanja (xorshift64*) umesto globalnog rand(), da bi igra bila ponovljiva iz semena
+static inline uint32_t xorshift_next(uint64_t* s) {
+    *s ^= *s >> 12; *s ^= *s << 25; *s ^= *s >> 27;
+    return (uint32_t)((*s * 0x2545F4914F6CDD1DULL) >> 33);
+}
+static inline uint32_t game_rand(GameState* g) { return xorshift_next(&g->rng); }
+static inline uint32_t star_rand(GameState* g) { return xorshift_next(&g->star_rng); }
+
+// HSV -> RGB konverzija (h,s,v u [0,1])
+static inline Vec3 hsv_to_rgb(float h, float s, float v) {
+    if (s <= 0.0f) return (Vec3){v, v, v};
+    h = fmodf(h, 1.0f); if (h < 0.0f) h += 1.0f;
+    float hf = h * 6.0f;
+    int i = (int)floorf(hf);
+    float f = hf - i;
+    float p = v * (1.0f - s);
+    float q = v * (1.0f - s * f);
+    float t = v * (1.0f - s * (1.0f - f));
+    switch (i % 6) {
+        case 0: return (Vec3){v, t, p};
+        case 1: return (Vec3){q, v, p};
+        case 2: return (Vec3){p, v, t};
+        case 3: return (Vec3){p, q, v};
+        case 4: return (Vec3){t, p, v};
+        default: return (Vec3){v, p, q};
+    }
+}
+
+#define ASTEROID_WORDS BITSET_WORDS(MAX_ASTEROIDS)
+#define BULLET_WORDS BITSET_WORDS(MAX_BULLETS)
+#define FOR_EACH_ASTEROID(g, i) BITSET_FOR_EACH((g)->asteroid_live, ASTEROID_WORDS, i)
+#define FOR_EACH_BULLET(g, i) BITSET_FOR_EACH((g)->bullet_live, BULLET_WORDS, i)
+
+void initialize_game(GameState* g, uint32_t seed);
+void shoot_bullet(GameState* g);
+void spawn_asteroid(GameState* g);
+// Pomera igraca i puca po ulazu; posle kraja igre ne radi nista
+void apply_input(GameState* g, const GameInput* in, double dt);
+// Swept sudari metak-asteroid za jedan korak (deo update_state; izdvojeno zbog benchmark-a)
+void resolve_bullet_hits(GameState* g);
+// Vraca 1 u frejmu u kom se igra zavrsila (pozivalac upisuje rezultat)
+int update_state(GameState* g, double dt);
+
+#endif
@@ -0,0 +1,121 @@
+#define _POSIX_C_SOURCE 200809L
+#include "gl_instrument.h"
+
+#ifdef GL_INSTRUMENT
+
+#include <glad/glad.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define GL_REPORT_FRAMES 300
+#define UNIFORM_CACHE_SIZE 64
+
+// X(ime, tip pokazivaca, parametri, argumenti, izraz: 1 ako je poziv suvisan)
+#define GL_WRAPPED(X) \
+    X(Clear, PFNGLCLEARPROC, (GLbitfield mask), (mask), 0) \
+    X(ClearColor, PFNGLCLEARCOLORPROC, (GLfloat r, GLfloat g, GLfloat b, GLfloat a), (r, g, b, a), (same_clear_color(r, g, b, a))) \
+    X(UseProgram, PFNGLUSEPROGRAMPROC, (GLuint program), (program), same_program(program)) \
+    X(BindVertexArray, PFNGLBINDVERTEXARRAYPROC, (GLuint array), (array), same_vao(array)) \
+    X(BindBuffer, PFNGLBINDBUFFERPROC, (GLenum target, GLuint buffer), (target, buffer), (same_buffer(target, buffer))) \
+    X(BufferData, PFNGLBUFFERDATAPROC, (GLenum target, GLsizeiptr size, const void* data, GLenum usage), (target, size, data, usage), note_upload(size)) \
+    X(BufferSubData, PFNGLBUFFERSUBDATAPROC, (GLenum target, GLintptr offset, GLsizeiptr size, const void* data), (target, offset, size, data), note_upload(size)) \
+    X(DrawArrays, PFNGLDRAWARRAYSPROC, (GLenum mode, GLint first, GLsizei count), (mode, first, count), note_draw(1)) \
+    X(DrawElements, PFNGLDRAWELEMENTSPROC, (GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices), note_draw(1)) \
+    X(DrawArraysInstanced, PFNGLDRAWARRAYSINSTANCEDPROC, (GLenum mode, GLint first, GLsizei count, GLsizei n), (mode, first, count, n), note_draw(n)) \
+    X(DrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei n), (mode, count, type, indices, n), note_draw(n)) \
+    X(Uniform1f, PFNGLUNIFORM1FPROC, (GLint location, GLfloat v0), (location, v0), (same_uniform(location, float_bits(v0)))) \
+    X(Uniform1i, PFNGLUNIFORM1IPROC, (GLint location, GLint v0), (location, v0), (same_uniform(location, (uint32_t)v0))) \
+    X(VertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC, (GLuint index, GLint size, GLenum type, GLboolean norm, GLsizei stride, const void* ptr), (index, size, type, norm, stride, ptr), 0) \
+    X(EnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYPROC, (GLuint index), (index), 0) \
+    X(VertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC, (GLuint index, GLuint divisor), (index, divisor), 0)
+
+#define X(name, pfn, params, args, check) GLI_##name,
+enum { GL_WRAPPED(X) GLI_COUNT };
+#undef X
+#define X(name, pfn, params, args, check) "gl" #name,
+static const char* gl_names[GLI_COUNT] = { GL_WRAPPED(X) };
+#undef X
+
+// Brojaci tekuceg prozora izvestaja (zbir preko frejmova)
+static uint64_t calls[GLI_COUNT], redundant[GLI_COUNT], driver_ns[GLI_COUNT];
+static uint64_t draws, instances, upload_bytes, frames;
+static uint64_t frame_ns, max_frame_ns, frame_draws, max_frame_draws;
+
+// Poslednje poznato stanje (GL_ARRAY_BUFFER je globalno, ELEMENT_ARRAY pripada VAO-u pa se ne prati)
+static GLuint cur_program, cur_vao, cur_array_buffer;
+static int have_program, have_vao, have_array_buffer, have_clear_color;
+static GLfloat cur_clear[4];
+typedef struct { GLuint program; GLint location; uint32_t bits; } UniformValue;
+static UniformValue uniform_cache[UNIFORM_CACHE_SIZE];
+static int uniform_count = 0;
+
+static uint64_t now_ns() { struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return (uint64_t)t.tv_sec * 1000000000ull + (uint64_t)t.tv_nsec; }
+static uint32_t float_bits(GLfloat v) { uint32_t b; memcpy(&b, &v, sizeof(b)); return b; }
+
+static int same_program(GLuint p) { int same = have_program && cur_program == p; cur_program = p; have_program = 1; return same; }
+static int same_vao(GLuint v) { int same = have_vao && cur_vao == v; cur_vao = v; have_vao = 1; return same; }
+static int same_buffer(GLenum target, GLuint b) {
+    if (target != GL_ARRAY_BUFFER) return 0;
+    int same = have_array_buffer && cur_array_buffer == b; cur_array_buffer = b; have_array_buffer = 1; return same;
+}
+static int same_clear_color(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+    GLfloat c[4] = { r, g, b, a };
+    int same = have_clear_color && memcmp(c, cur_clear, sizeof(c)) == 0;
+    memcpy(cur_clear, c, sizeof(c)); have_clear_color = 1; return same;
+}
+// Uniform pripada aktivnom programu; kad se kes napuni, novi uniformi se ne prate
+static int same_uniform(GLint location, uint32_t bits) {
+    for (int i = 0; i < uniform_count; i++) {
+        UniformValue* u = &uniform_cache[i];
+        if (u->program != cur_program || u->location != location) continue;
+        int same = u->bits == bits; u->bits = bits; return same;
+    }
+    if (uniform_count < UNIFORM_CACHE_SIZE) uniform_cache[uniform_count++] = (UniformValue){ cur_program, location, bits };
+    return 0;
+}
+static int note_upload(GLsizeiptr size) { upload_bytes += (uint64_t)size; return 0; }
+static int note_draw(GLsizei n) { draws++; frame_draws++; instances += (uint64_t)n; return 0; }
+
+static void count_call(int i, uint64_t ns, int is_redundant) { calls[i]++; redundant[i] += (uint64_t)is_redundant; driver_ns[i] += ns; frame_ns += ns; }
+
+#define X(name, pfn, params, args, check) \
+    static pfn real_##name; \
+    static void APIENTRY wrap_##name params { int is_redundant_ = check; uint64_t t0_ = now_ns(); real_##name args; count_call(GLI_##name, now_ns() - t0_, is_redundant_); }
+GL_WRAPPED(X)
+#undef X
+
+void gl_instrument_install() {
+#define X(name, pfn, params, args, check) if (glad_gl##name != NULL && glad_gl##name != wrap_##name) { real_##name = glad_gl##name; glad_gl##name = wrap_##name; }
+    GL_WRAPPED(X)
+#undef X
+}
+
+void gl_instrument_report() {
+    if (frames == 0) return;
+    double f = (double)frames;
+    uint64_t total_calls = 0, total_redundant = 0, total_ns = 0;
+    for (int i = 0; i < GLI_COUNT; i++) { total_calls += calls[i]; total_redundant += redundant[i]; total_ns += driver_ns[i]; }
+    printf("GL [%llu frejmova] poziva/frejm %.1f (suvisnih %.1f) | draw %.1f (max %llu), instanci %.0f | upload %.1f KB | drajver %.3f ms/frejm (max %.3f)\n",
+           (unsigned long long)frames, total_calls / f, total_redundant / f, draws / f, (unsigned long long)max_frame_draws, instances / f,
+           upload_bytes / f / 1024.0, total_ns / f / 1e6, max_frame_ns / 1e6);
+    for (int i = 0; i < GLI_COUNT; i++) {
+        if (calls[i] == 0) continue;
+        printf("  %-26s %8.1f/frejm  suvisno %6.1f  %8.1f us/frejm\n", gl_names[i], calls[i] / f, redundant[i] / f, driver_ns[i] / f / 1e3);
+    }
+    fflush(stdout);
+    memset(calls, 0, sizeof(calls)); memset(redundant, 0, sizeof(redundant)); memset(driver_ns, 0, sizeof(driver_ns));
+    draws = instances = upload_bytes = frames = max_frame_ns = max_frame_draws = 0;
+}
+
+void gl_instrument_frame_end() {
+    if (frame_ns > max_frame_ns) max_frame_ns = frame_ns;
+    if (frame_draws > max_frame_draws) max_frame_draws = frame_draws;
+    frame_ns = frame_draws = 0;
+    if (++frames == GL_REPORT_FRAMES) gl_instrument_report();
+}
+
+#else
+typedef int gl_instrument_disabled;   // ISO C ne dozvoljava prazan translation unit
+#endif
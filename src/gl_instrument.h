@@ -0,0 +1,26 @@
+#ifndef GL_INSTRUMENT_H
+#define GL_INSTRUMENT_H
+
+// --- Instrumentacija GL poziva ---
+// Samo u build-u sa -DGL_INSTRUMENT (`make clean && make GL_INSTRUMENT=1`).
+// Posle gladLoadGLLoader, gl_instrument_install zamenjuje glad_gl* pokazivace
+// funkcija koje se zovu svakog frejma omotacima koji broje pozive, mere CPU
+// vreme provedeno u drajveru i prepoznaju suvisne promene stanja (isti
+// program, VAO, buffer, uniform vrednost). Poziv se uvek prosledjuje drajveru;
+// izvestaj meri saobracaj, a ne menja ga.
+#ifdef GL_INSTRUMENT
+
+void gl_instrument_install();
+// Kraj frejma (posle swap-a); na svakih GL_REPORT_FRAMES frejmova ispisuje izvestaj
+void gl_instrument_frame_end();
+// Ispisuje proseke po frejmu od poslednjeg izvestaja
+void gl_instrument_report();
+
+#else
+
+#define gl_instrument_install() ((void)0)
+#define gl_instrument_frame_end() ((void)0)
+
+#endif
+
+#endif
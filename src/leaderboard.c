@@ -0,0 +1,707 @@
+#define _POSIX_C_SOURCE 200809L
+#include "leaderboard.h"
+#include "arena.h"
+#include "leaderboard_client.h"
+#include "leaderboard_text.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+LeaderboardEntry leaderboard[LEADERBOARD_SIZE];
+int leaderboard_count = 0;
+ScoreIndex score_index;
+QuantileSketch leaderboard_sketches[SKETCH_COUNT];
+
+#define LB_PATH_MAX 128
+#define LB_QUEUE_SIZE 1024          // stepen dvojke; daleko vise nego krajeva igre po budjenju
+#define LB_IO_INTERVAL_NS 20000000L // I/O nit se budi na 20 ms
+#define LB_COMPACT_RECORDS 512      // kompakcija kad se zurnal ovoliko naraste...
+#define LB_COMPACT_SECONDS 30       // ...ili kad je neutopljen ovoliko dugo
+#define LB_RECONNECT_SECONDS 2      // pauza izmedju pokusaja povezivanja na server
+#define LB_STOP_ACK_WAIT 50         // pri gasenju, koliko budjenja (x LB_IO_INTERVAL_NS) se ceka na potvrde servera
+
+// Putanje aktivnog sharda; podrazumevano globalni fajlovi u radnom direktorijumu
+static char profile_name[LEADERBOARD_PROFILE_MAX + 1] = "";
+static char path_bin[LB_PATH_MAX] = LEADERBOARD_BIN;
+static char path_journal[LB_PATH_MAX] = LEADERBOARD_JOURNAL, path_sketch[LB_PATH_MAX] = LEADERBOARD_SKETCH;
+
+// SPSC red: frejm nit pise head, I/O nit pise tail
+typedef struct { LeaderboardEntry entry; float survival; } LeaderboardPost;
+static LeaderboardPost lb_queue[LB_QUEUE_SIZE];
+static atomic_uint lb_head, lb_tail;
+static atomic_int lb_stop;
+static pthread_t lb_thread;
+static int lb_thread_running = 0;
+static unsigned long lb_dropped = 0;
+
+// Stanje zurnala; posle load_leaderboard pripada I/O niti (ili pozivaocu ako nit ne radi)
+static JournalRecord* pending = NULL;   // zapisi u zurnalu koji jos nisu u snimku
+static size_t pending_count = 0, pending_cap = 0;
+static uint32_t folded_seq = 0, next_seq = 1;
+static int journal_fd = -1;
+static time_t last_compaction = 0;
+// Kopija sketch-eva koju azurira i snima I/O nit
+static QuantileSketch io_sketches[SKETCH_COUNT];
+// Klijentski rezim: rezultati idu na server, lokalni zurnal je rezerva
+static const char* server_path = NULL;
+static time_t last_connect_attempt = 0;
+// Poslednja potvrda servera za frejm nit (seqlock: seq je neparan dok I/O nit pise)
+static atomic_uint ack_seq;
+static atomic_int ack_score;
+static _Atomic uint64_t ack_rank, ack_total;
+
+void format_timestamp(int64_t epoch_time, char* buf) {
+    time_t t = (time_t)epoch_time; struct tm tm_info;
+    localtime_r(&t, &tm_info);
+    strftime(buf, 30, "%Y-%m-%d %H:%M:%S", &tm_info);
+}
+
+void print_full_leaderboard() {
+    char ts[30];
+    printf("\n--- KOMPLETAN LEADERBOARD ---\n");
+    for (int i = 0; i < leaderboard_count; i++) { format_timestamp(leaderboard[i].epoch_time, ts); printf("%d. %d poena (%s)\n", i + 1, (int)leaderboard[i].score, ts); }
+    printf("---------------------------\n"); fflush(stdout);
+}
+// Ubacuje zapis na svoje mesto u opadajuce sortiran niz (iza jednakih); 0 ako ne ulazi
+static int insert_sorted(LeaderboardEntry* board, int* count, LeaderboardEntry e) {
+    if (*count == LEADERBOARD_SIZE && e.score <= board[*count - 1].score) return 0;
+    int pos = *count;
+    while (pos > 0 && board[pos - 1].score < e.score) pos--;
+    int n = (*count < LEADERBOARD_SIZE) ? (*count)++ : LEADERBOARD_SIZE - 1;
+    memmove(&board[pos + 1], &board[pos], (size_t)(n - pos) * sizeof(LeaderboardEntry));
+    board[pos] = e;
+    return 1;
+}
+static int compare_scores(const void* a, const void* b) {
+    int32_t x = ((const LeaderboardEntry*)a)->score, y = ((const LeaderboardEntry*)b)->score;
+    return (y > x) - (y < x);
+}
+// Opadajuce po rezultatu, a za iste rezultate stariji (manji seq) prvi
+static int compare_journal(const void* a, const void* b) {
+    const JournalRecord* x = a; const JournalRecord* y = b;
+    if (x->score != y->score) return (y->score > x->score) - (y->score < x->score);
+    return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+// --- Run-ovi ---
+typedef struct {
+    void* map; size_t map_size;
+    const LeaderboardEntry* entries; size_t count;
+    const ScoreCount* hist; size_t hist_count; int has_hist;   // histogram od verzije 3
+    uint32_t folded_seq, gen_lo, gen_hi;
+} SnapshotView;
+
+static int snapshot_open(const char* path, SnapshotView* v) {
+    *v = (SnapshotView){0};
+    int fd = open(path, O_RDONLY); if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < LEADERBOARD_HEADER_V1_SIZE) { close(fd); return 0; }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+    const LeaderboardHeader* h = map;
+    size_t header_size = h->version == 1 ? LEADERBOARD_HEADER_V1_SIZE : h->version == 2 ? LEADERBOARD_HEADER_V2_SIZE : sizeof(LeaderboardHeader);
+    if (memcmp(h->magic, LEADERBOARD_MAGIC, 4) != 0 || h->version < 1 || h->version > LEADERBOARD_VERSION ||
+        h->record_size != sizeof(LeaderboardEntry) || (size_t)st.st_size < header_size) { munmap(map, (size_t)st.st_size); return 0; }
+    size_t available = ((size_t)st.st_size - header_size) / sizeof(LeaderboardEntry);
+    v->map = map; v->map_size = (size_t)st.st_size;
+    v->entries = (const LeaderboardEntry*)((const unsigned char*)map + header_size);
+    v->count = h->count < available ? h->count : available;
+    v->folded_seq = (h->version >= 2) ? h->folded_seq : 0;
+    if (h->version >= 3) {
+        v->gen_lo = h->gen_lo; v->gen_hi = h->gen_hi;
+        size_t hist_offset = header_size + v->count * sizeof(LeaderboardEntry);
+        if (v->count == h->count && ((size_t)st.st_size - hist_offset) / sizeof(ScoreCount) >= h->hist_count) {
+            v->hist = (const ScoreCount*)((const unsigned char*)map + hist_offset);
+            v->hist_count = h->hist_count; v->has_hist = 1;
+        }
+    }
+    return 1;
+}
+
+static void snapshot_close(SnapshotView* v) { if (v->map != NULL) munmap(v->map, v->map_size); *v = (SnapshotView){0}; }
+
+// Jedan sortiran niz (run) za spajanje: run sa diska, rep zurnala ili uvezeni rezultati
+typedef struct { const LeaderboardEntry* items; size_t count, pos; } MergeRun;
+
+// Max-hip nad glavama run-ova
+static void heap_sift_down(MergeRun** heap, int n, int i) {
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, best = i;
+        if (l < n && heap[l]->items[heap[l]->pos].score > heap[best]->items[heap[best]->pos].score) best = l;
+        if (r < n && heap[r]->items[heap[r]->pos].score > heap[best]->items[heap[best]->pos].score) best = r;
+        if (best == i) return;
+        MergeRun* t = heap[i]; heap[i] = heap[best]; heap[best] = t;
+        i = best;
+    }
+}
+
+// k-way spajanje: samo prvih n, pa je cena O(n log k) bez obzira na velicinu run-ova; heap ima mesta za run_count
+static int merge_top(MergeRun* runs, int run_count, MergeRun** heap, LeaderboardEntry* out, int n) {
+    int heap_n = 0, got = 0;
+    for (int i = 0; i < run_count; i++) if (runs[i].pos < runs[i].count) heap[heap_n++] = &runs[i];
+    for (int i = heap_n / 2 - 1; i >= 0; i--) heap_sift_down(heap, heap_n, i);
+    while (got < n && heap_n > 0) {
+        MergeRun* top = heap[0];
+        out[got++] = top->items[top->pos++];
+        if (top->pos == top->count) heap[0] = heap[--heap_n];
+        heap_sift_down(heap, heap_n, 0);
+    }
+    return got;
+}
+
+static void run_path(char* out, size_t cap, const char* bin, int slot) {
+    if (slot == 0) snprintf(out, cap, "%s", bin); else snprintf(out, cap, "%s.%d", bin, slot);
+}
+
+// Svi run-ovi sharda; mesto i je <bin>.i (0 je sam <bin>), prazno mesto ima map == NULL
+typedef struct { SnapshotView run[LEADERBOARD_RUNS]; uint32_t folded_seq, next_gen; } RunSet;
+
+// Run ciji opseg generacija pokriva siri run je vec spojen u njega; zatvara se,
+// a sa remove_stale (samo vlasnik sharda) i brise
+static void runs_open(const char* bin, RunSet* rs, int remove_stale) {
+    char path[LB_PATH_MAX + 80];
+    rs->folded_seq = 0; rs->next_gen = 1;
+    for (int i = 0; i < LEADERBOARD_RUNS; i++) { run_path(path, sizeof(path), bin, i); snapshot_open(path, &rs->run[i]); }
+    for (int i = 0; i < LEADERBOARD_RUNS; i++) {
+        SnapshotView* a = &rs->run[i];
+        if (a->map == NULL) continue;
+        if (a->gen_hi >= rs->next_gen) rs->next_gen = a->gen_hi + 1;
+        for (int j = 0; j < LEADERBOARD_RUNS; j++) {
+            const SnapshotView* b = &rs->run[j];
+            if (j == i || b->map == NULL || b->gen_lo > a->gen_lo || b->gen_hi < a->gen_hi || b->gen_hi - b->gen_lo <= a->gen_hi - a->gen_lo) continue;
+            snapshot_close(a);
+            if (remove_stale) { run_path(path, sizeof(path), bin, i); remove(path); }
+            break;
+        }
+        if (a->map != NULL && a->folded_seq > rs->folded_seq) rs->folded_seq = a->folded_seq;
+    }
+}
+
+static void runs_close(RunSet* rs) { for (int i = 0; i < LEADERBOARD_RUNS; i++) snapshot_close(&rs->run[i]); }
+
+// Spaja sortirane izvore u novi run na putanji path (temp + fsync + rename); jednaki
+// rezultati idu redom izvora (stariji run prvi). Histogram se pravi usput.
+static int run_write(const char* path, MergeRun* src, int n_src, uint32_t gen_lo, uint32_t gen_hi, uint32_t folded) {
+    char tmp[LB_PATH_MAX + 96];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* file = fopen(tmp, "wb"); if (file == NULL) return 0;
+    setvbuf(file, NULL, _IOFBF, 1 << 16);
+    LeaderboardHeader h = { .version = LEADERBOARD_VERSION, .record_size = sizeof(LeaderboardEntry), .folded_seq = folded, .gen_lo = gen_lo, .gen_hi = gen_hi };
+    memcpy(h.magic, LEADERBOARD_MAGIC, 4);
+    fwrite(&h, sizeof(h), 1, file);
+    ScoreCount* hist = NULL; size_t hist_cap = 0;
+    int ok = 1;
+    for (;;) {
+        int best = -1;
+        for (int i = 0; i < n_src; i++)
+            if (src[i].pos < src[i].count && (best < 0 || src[i].items[src[i].pos].score > src[best].items[src[best].pos].score)) best = i;
+        if (best < 0) break;
+        LeaderboardEntry e = src[best].items[src[best].pos++];
+        fwrite(&e, sizeof(e), 1, file);
+        h.count++;
+        if (h.hist_count > 0 && hist[h.hist_count - 1].score == e.score) { hist[h.hist_count - 1].count++; continue; }
+        if (h.hist_count == hist_cap) {
+            hist_cap = hist_cap ? hist_cap * 2 : 1024;
+            ScoreCount* grown = realloc(hist, hist_cap * sizeof(ScoreCount));
+            if (grown == NULL) { ok = 0; break; }
+            hist = grown;
+        }
+        hist[h.hist_count++] = (ScoreCount){ e.score, 1 };
+    }
+    if (ok) fwrite(hist, sizeof(ScoreCount), h.hist_count, file);
+    free(hist);
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, file) == 1;
+    ok = ok && !ferror(file) && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    fclose(file);
+    if (ok && rename(tmp, path) == 0) return 1;
+    remove(tmp);
+    return 0;
+}
+
+// --- Zurnal ---
+static void pending_push(JournalRecord r) {
+    if (pending_count == pending_cap) {
+        size_t cap = pending_cap ? pending_cap * 2 : 256;
+        JournalRecord* grown = realloc(pending, cap * sizeof(JournalRecord));
+        if (grown == NULL) return;
+        pending = grown; pending_cap = cap;
+    }
+    pending[pending_count++] = r;
+}
+
+static int journal_open() {
+    if (journal_fd < 0) journal_fd = open(path_journal, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    return journal_fd >= 0;
+}
+
+// Odseca nepotpun zapis na kraju (pad ili kratak write): zurnal se otvara sa
+// O_APPEND, pa bi svaki sledeci zapis inace pocinjao na pogresnom pomeraju
+static void journal_trim(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size % (off_t)sizeof(JournalRecord) == 0) return;
+    if (ftruncate(fd, st.st_size - st.st_size % (off_t)sizeof(JournalRecord)) != 0) perror("leaderboard journal");
+}
+
+// Svi zapisi jednim write-om i jednim fsync-om (grupni commit)
+static void journal_append(const LeaderboardEntry* entries, size_t n) {
+    JournalRecord buf[64];
+    while (n > 0) {
+        size_t chunk = n < 64 ? n : 64;
+        for (size_t i = 0; i < chunk; i++) {
+            buf[i] = (JournalRecord){ .seq = next_seq++, .score = entries[i].score, .epoch_time = entries[i].epoch_time };
+            pending_push(buf[i]);
+        }
+        if (journal_open()) {
+            ssize_t wrote = write(journal_fd, buf, chunk * sizeof(JournalRecord));
+            if (wrote != (ssize_t)(chunk * sizeof(JournalRecord))) {
+                if (wrote < 0) perror("leaderboard journal"); else fprintf(stderr, "leaderboard journal: kratak upis (%zd bajtova)\n", wrote);
+                journal_trim(journal_fd);
+            }
+        }
+        entries += chunk; n -= chunk;
+    }
+    if (journal_fd >= 0) fsync(journal_fd);
+}
+
+// Zapisi zurnala (sortira ih) postaju novi run, spojen sa novijim run-ovima koji
+// nisu bar LEADERBOARD_RUN_FACTOR puta veci od onoga sto se spaja. Cena je
+// amortizovano O(log n) upisa po igri umesto prepisivanja cele istorije.
+static int runs_append(JournalRecord* recs, size_t n, uint32_t max_seq) {
+    qsort(recs, n, sizeof(JournalRecord), compare_journal);
+    LeaderboardEntry* tail = malloc(n * sizeof(LeaderboardEntry));
+    if (tail == NULL) return 0;
+    for (size_t i = 0; i < n; i++) tail[i] = (LeaderboardEntry){ recs[i].score, recs[i].epoch_time };
+    RunSet rs; runs_open(path_bin, &rs, 0);
+    int occupied[LEADERBOARD_RUNS], k = 0;
+    for (int i = 0; i < LEADERBOARD_RUNS; i++) if (rs.run[i].map != NULL) occupied[k++] = i;
+    int next_free = k > 0 ? occupied[k - 1] + 1 : 0, first = k;
+    size_t size = n;
+    // Sva mesta zauzeta: novi run se obavezno spaja bar sa poslednjim
+    while (first > 0 && ((first == k && next_free == LEADERBOARD_RUNS) || rs.run[occupied[first - 1]].count <= LEADERBOARD_RUN_FACTOR * size))
+        size += rs.run[occupied[--first]].count;
+    MergeRun src[LEADERBOARD_RUNS + 1]; int n_src = 0;
+    for (int i = first; i < k; i++) src[n_src++] = (MergeRun){ rs.run[occupied[i]].entries, rs.run[occupied[i]].count, 0 };
+    src[n_src++] = (MergeRun){ tail, n, 0 };
+    int target = first < k ? occupied[first] : next_free;
+    char path[LB_PATH_MAX + 80];
+    run_path(path, sizeof(path), path_bin, target);
+    int ok = run_write(path, src, n_src, first < k ? rs.run[target].gen_lo : rs.next_gen, rs.next_gen, max_seq);
+    runs_close(&rs);
+    // Pad pre ovih brisanja ostavlja run-ove koje novi pokriva; runs_open ih preskace
+    if (ok) for (int i = first + 1; i < k; i++) { run_path(path, sizeof(path), path_bin, occupied[i]); remove(path); }
+    free(tail);
+    return ok;
+}
+
+static uint32_t pending_max_seq() {
+    uint32_t max_seq = folded_seq;
+    for (size_t i = 0; i < pending_count; i++) if (pending[i].seq > max_seq) max_seq = pending[i].seq;
+    return max_seq;
+}
+
+// Utapa zurnal u run-ove
+static void compact_journal() {
+    last_compaction = time(NULL);
+    if (pending_count == 0) return;
+    uint32_t max_seq = pending_max_seq();
+    if (!runs_append(pending, pending_count, max_seq)) return;
+    folded_seq = max_seq;
+    pending_count = 0;
+    if (journal_open() && ftruncate(journal_fd, 0) == 0) fsync(journal_fd);
+}
+
+// Jednokratna migracija starog tekstualnog formata ("score YYYY-MM-DD HH:MM:SS"); prenosi se cela istorija
+static void migrate_text_leaderboard() {
+    LeaderboardEntry* entries; size_t skipped;
+    long n = leaderboard_read_text_file(LEADERBOARD_TXT, &entries, &skipped);
+    if (n <= 0) { free(entries); return; }
+    qsort(entries, (size_t)n, sizeof(LeaderboardEntry), compare_scores);
+    MergeRun src = { entries, (size_t)n, 0 };
+    if (run_write(path_bin, &src, 1, 1, 1, 0)) { printf("Leaderboard prebacen iz %s u %s (%ld zapisa, %zu neispravnih linija)\n", LEADERBOARD_TXT, path_bin, n, skipped); fflush(stdout); }
+    free(entries);
+}
+
+// --- Profili ---
+int leaderboard_set_profile(const char* name) {
+    size_t len = strlen(name);
+    if (len == 0 || len > LEADERBOARD_PROFILE_MAX) return 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = name[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-')) return 0;
+    }
+    if (mkdir(LEADERBOARD_DIR, 0755) != 0 && errno != EEXIST) return 0;
+    memcpy(profile_name, name, len + 1);
+    snprintf(path_bin, sizeof(path_bin), "%s/%s.bin", LEADERBOARD_DIR, name);
+    snprintf(path_journal, sizeof(path_journal), "%s/%s.journal", LEADERBOARD_DIR, name);
+    snprintf(path_sketch, sizeof(path_sketch), "%s/%s.sketch", LEADERBOARD_DIR, name);
+    return 1;
+}
+
+const char* leaderboard_profile() { return profile_name; }
+
+// Run-ovi daju najboljih LEADERBOARD_SIZE i indeks (iz histograma), a rep zurnala (posle folded_seq) se dodaje preko njih
+void load_leaderboard() {
+    leaderboard_count = 0;
+    pending_count = 0;
+    if (!quantile_sketch_load(path_sketch, leaderboard_sketches, SKETCH_COUNT))
+        for (int i = 0; i < SKETCH_COUNT; i++) quantile_sketch_init(&leaderboard_sketches[i]);
+    score_index_free(&score_index);
+    score_index_init(&score_index, 4096);
+    // Stari tekstualni fajl pripada globalnom (podrazumevanom) leaderboard-u
+    if (profile_name[0] == '\0' && access(path_bin, F_OK) != 0) migrate_text_leaderboard();
+    RunSet rs; runs_open(path_bin, &rs, 1);
+    MergeRun runs[LEADERBOARD_RUNS]; MergeRun* heap[LEADERBOARD_RUNS]; int run_count = 0;
+    char path[LB_PATH_MAX + 80];
+    for (int i = 0; i < LEADERBOARD_RUNS; i++) {
+        const SnapshotView* v = &rs.run[i];
+        if (v->map == NULL) continue;
+        runs[run_count++] = (MergeRun){ v->entries, v->count, 0 };
+        if (v->has_hist) { for (size_t j = 0; j < v->hist_count; j++) score_index_add(&score_index, v->hist[j].score, v->hist[j].count); continue; }
+        // Run bez histograma (stari format): jednom se prodje i prepise sa histogramom
+        for (size_t a = 0; a < v->count; ) {
+            size_t b = a + 1;
+            while (b < v->count && v->entries[b].score == v->entries[a].score) b++;
+            score_index_add(&score_index, v->entries[a].score, (uint32_t)(b - a));
+            a = b;
+        }
+        MergeRun src = { v->entries, v->count, 0 };
+        run_path(path, sizeof(path), path_bin, i);
+        run_write(path, &src, 1, v->gen_lo, v->gen_hi, v->folded_seq);
+    }
+    leaderboard_count = merge_top(runs, run_count, heap, leaderboard, LEADERBOARD_SIZE);
+    folded_seq = rs.folded_seq;
+    runs_close(&rs);
+    next_seq = folded_seq + 1;
+
+    int fd = open(path_journal, O_RDWR);
+    if (fd >= 0) journal_trim(fd);   // nepotpun zapis na kraju (pad usred upisa) se odseca pre sledeceg upisa
+    else if ((fd = open(path_journal, O_RDONLY)) < 0) return;
+    JournalRecord buf[256]; ssize_t got;
+    while ((got = read(fd, buf, sizeof(buf))) >= (ssize_t)sizeof(JournalRecord)) {
+        for (size_t i = 0; i < (size_t)got / sizeof(JournalRecord); i++) {
+            if (buf[i].seq <= folded_seq) continue;
+            pending_push(buf[i]);
+            insert_sorted(leaderboard, &leaderboard_count, (LeaderboardEntry){ buf[i].score, buf[i].epoch_time });
+            score_index_add(&score_index, buf[i].score, 1);
+            if (buf[i].seq >= next_seq) next_seq = buf[i].seq + 1;
+        }
+    }
+    close(fd);
+}
+
+// --- Globalni pregled ---
+// Rep zurnala sharda kao sortiran niz (scratch_alloc, velicina iz fstat); NULL ako ga nema
+static LeaderboardEntry* journal_tail_sorted(const char* path, uint32_t folded, size_t* count) {
+    *count = 0;
+    int fd = open(path, O_RDONLY); if (fd < 0) return NULL;
+    struct stat st;
+    size_t cap = fstat(fd, &st) == 0 ? (size_t)st.st_size / sizeof(JournalRecord) : 0;
+    LeaderboardEntry* out = cap > 0 ? scratch_alloc(cap * sizeof(LeaderboardEntry)) : NULL;
+    if (out == NULL) { close(fd); return NULL; }
+    JournalRecord buf[256]; ssize_t got;
+    while (*count < cap && (got = read(fd, buf, sizeof(buf))) >= (ssize_t)sizeof(JournalRecord)) {
+        for (size_t i = 0; i < (size_t)got / sizeof(JournalRecord) && *count < cap; i++)
+            if (buf[i].seq > folded) out[(*count)++] = (LeaderboardEntry){ buf[i].score, buf[i].epoch_time };
+    }
+    close(fd);
+    qsort(out, *count, sizeof(LeaderboardEntry), compare_scores);
+    return out;
+}
+
+#define LB_MAX_SHARDS 256
+
+int leaderboard_global_top(LeaderboardEntry* out, int n) {
+    // Klijentski rezim: zajednicka tabela je na serveru; lokalni fajlovi samo dok je nedostupan
+    if (server_path != NULL) { int got = lb_client_fetch_top(server_path, out, n < LEADERBOARD_SIZE ? n : LEADERBOARD_SIZE); if (got >= 0) return got; }
+    // Po shardu svi run-ovi + rep zurnala; za 256 shardova to je vise od steka, pa scratch
+    RunSet* sets = scratch_alloc(LB_MAX_SHARDS * sizeof(RunSet));
+    MergeRun* runs = scratch_alloc(LB_MAX_SHARDS * (LEADERBOARD_RUNS + 1) * sizeof(MergeRun));
+    MergeRun** heap = scratch_alloc(LB_MAX_SHARDS * (LEADERBOARD_RUNS + 1) * sizeof(MergeRun*));
+    LeaderboardEntry* tails[LB_MAX_SHARDS];
+    int shards = 0, run_count = 0;
+    if (sets == NULL || runs == NULL || heap == NULL) { scratch_free(sets); scratch_free(runs); scratch_free(heap); return 0; }
+
+    // Globalni (podrazumevani) fajlovi + svi shardovi profila. Shard se prepoznaje po .bin,
+    // ili po .journal dok novi profil jos nema nijednu kompakciju.
+    char bin[LB_PATH_MAX + 64], journal[LB_PATH_MAX + 64];
+    DIR* dir = opendir(LEADERBOARD_DIR);
+    struct dirent* de = NULL;
+    for (int first = 1; shards < LB_MAX_SHARDS; first = 0) {
+        if (first) { snprintf(bin, sizeof(bin), "%s", LEADERBOARD_BIN); snprintf(journal, sizeof(journal), "%s", LEADERBOARD_JOURNAL); }
+        else {
+            if (dir == NULL || (de = readdir(dir)) == NULL) break;
+            size_t len = strlen(de->d_name), stem;
+            if (len > 4 && strcmp(de->d_name + len - 4, ".bin") == 0) stem = len - 4;
+            else if (len > 8 && strcmp(de->d_name + len - 8, ".journal") == 0) stem = len - 8;
+            else continue;
+            if (stem > LEADERBOARD_PROFILE_MAX) continue;
+            snprintf(bin, sizeof(bin), "%s/%.*s.bin", LEADERBOARD_DIR, (int)stem, de->d_name);
+            snprintf(journal, sizeof(journal), "%s/%.*s.journal", LEADERBOARD_DIR, (int)stem, de->d_name);
+            if (de->d_name[stem] == '.' && de->d_name[stem + 1] == 'j' && access(bin, F_OK) == 0) continue;   // vec obradjen preko .bin
+        }
+        RunSet* set = &sets[shards];
+        runs_open(bin, set, 0);
+        for (int i = 0; i < LEADERBOARD_RUNS; i++)
+            if (set->run[i].count > 0) runs[run_count++] = (MergeRun){ set->run[i].entries, set->run[i].count, 0 };
+        size_t tail_count;
+        tails[shards] = journal_tail_sorted(journal, set->folded_seq, &tail_count);
+        if (tail_count > 0) runs[run_count++] = (MergeRun){ tails[shards], tail_count, 0 };
+        shards++;
+    }
+    if (dir != NULL) closedir(dir);
+
+    int got = merge_top(runs, run_count, heap, out, n);
+    for (int i = 0; i < shards; i++) { runs_close(&sets[i]); scratch_free(tails[i]); tails[i] = NULL; }
+    scratch_free(heap); scratch_free(runs); scratch_free(sets);
+    return got;
+}
+
+// Uvoz tekstualnog leaderboard-a (npr. sa drugih kioska) u istoriju; utapa se odmah u snimak
+long leaderboard_import_text(const char* path) {
+    if (lb_thread_running) return -1;
+    LeaderboardEntry* entries; size_t skipped;
+    long n = leaderboard_read_text_file(path, &entries, &skipped);
+    if (n <= 0) { free(entries); return n; }
+    qsort(entries, (size_t)n, sizeof(LeaderboardEntry), compare_scores);
+    for (size_t i = 0; i < (size_t)n; ) {
+        size_t j = i + 1;
+        while (j < (size_t)n && entries[j].score == entries[i].score) j++;
+        score_index_add(&score_index, entries[i].score, (uint32_t)(j - i));
+        i = j;
+    }
+    for (size_t i = 0; i < (size_t)n; i++) {
+        if (i < LEADERBOARD_SIZE) insert_sorted(leaderboard, &leaderboard_count, entries[i]);
+        pending_push((JournalRecord){ .seq = next_seq++, .score = entries[i].score, .epoch_time = entries[i].epoch_time });
+        quantile_sketch_add(&leaderboard_sketches[SKETCH_SCORE], (float)entries[i].score);
+    }
+    free(entries);
+    compact_journal();
+    quantile_sketch_save(path_sketch, leaderboard_sketches, SKETCH_COUNT);
+    if (skipped > 0) fprintf(stderr, "%s: %zu neispravnih linija preskoceno\n", path, skipped);
+    return n;
+}
+
+static void sketches_add(QuantileSketch* sketches, int score, float survival) {
+    quantile_sketch_add(&sketches[SKETCH_SCORE], (float)score);
+    quantile_sketch_add(&sketches[SKETCH_SURVIVAL], survival);
+}
+
+int leaderboard_percentiles(int which, float out[3]) {
+    static const float qs[3] = {0.5f, 0.9f, 0.99f};
+    return quantile_sketch_query(&leaderboard_sketches[which], qs, out, 3);
+}
+
+void add_score_to_leaderboard(int new_score, float survival_seconds) {
+    LeaderboardEntry e = { .score = new_score, .epoch_time = (int64_t)time(NULL) };
+    insert_sorted(leaderboard, &leaderboard_count, e);
+    score_index_add(&score_index, e.score, 1);
+    sketches_add(leaderboard_sketches, new_score, survival_seconds);
+    // Zurnal cuva svaku igru, ne samo one koje ulaze u prikazanih LEADERBOARD_SIZE
+    if (!lb_thread_running) {
+        journal_append(&e, 1);
+        quantile_sketch_save(path_sketch, leaderboard_sketches, SKETCH_COUNT);
+        return;
+    }
+    unsigned head = atomic_load_explicit(&lb_head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&lb_tail, memory_order_acquire) == LB_QUEUE_SIZE) { lb_dropped++; return; }
+    lb_queue[head & (LB_QUEUE_SIZE - 1)] = (LeaderboardPost){ e, survival_seconds };
+    atomic_store_explicit(&lb_head, head + 1, memory_order_release);
+}
+
+// Rezultate koje server nije potvrdio upisuje lokalno (moguc duplikat ako je server upisao a potvrda se izgubila)
+static void server_fallback() {
+    LeaderboardEntry unacked[256]; size_t n;
+    while ((n = lb_client_close(unacked, 256)) > 0) journal_append(unacked, n);
+    fprintf(stderr, "Leaderboard server nedostupan, rezultati se upisuju lokalno\n");
+}
+
+static void publish_server_ack() {
+    LeaderboardEntry e; uint64_t rank, total;
+    if (!lb_client_take_ack(&e, &rank, &total)) return;
+    unsigned seq = atomic_load_explicit(&ack_seq, memory_order_relaxed);
+    atomic_store_explicit(&ack_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&ack_score, e.score, memory_order_relaxed);
+    atomic_store_explicit(&ack_rank, rank, memory_order_relaxed);
+    atomic_store_explicit(&ack_total, total, memory_order_relaxed);
+    atomic_store_explicit(&ack_seq, seq + 2, memory_order_release);
+}
+
+int leaderboard_server_rank(int32_t* score, uint64_t* rank, uint64_t* total) {
+    static unsigned seen = 0;
+    unsigned seq = atomic_load_explicit(&ack_seq, memory_order_acquire);
+    if ((seq & 1u) || seq == seen) return 0;
+    *score = atomic_load_explicit(&ack_score, memory_order_relaxed);
+    *rank = atomic_load_explicit(&ack_rank, memory_order_relaxed);
+    *total = atomic_load_explicit(&ack_total, memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&ack_seq, memory_order_relaxed) != seq) return 0;
+    seen = seq;
+    return 1;
+}
+
+// Salje serveru sta moze, ostatak dopisuje u zurnal
+static void leaderboard_io_write(const LeaderboardEntry* batch, const float* survival, size_t n) {
+    size_t sent = 0;
+    if (server_path != NULL && !lb_client_connected() && time(NULL) - last_connect_attempt >= LB_RECONNECT_SECONDS) {
+        last_connect_attempt = time(NULL);
+        lb_client_connect(server_path);
+    }
+    if (lb_client_connected()) sent = lb_client_submit(batch, survival, n);
+    if (sent < n) journal_append(batch + sent, n - sent);
+}
+
+// Preuzima sve sto je stiglo, dopisuje u zurnal jednim upisom (ili salje serveru) i snima sketch-eve
+static void leaderboard_io_drain() {
+    if (lb_client_connected() && !lb_client_poll()) server_fallback();
+    publish_server_ack();
+    unsigned tail = atomic_load_explicit(&lb_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&lb_head, memory_order_acquire);
+    if (tail == head) return;
+    LeaderboardEntry batch[64]; float survival[64]; size_t n = 0;
+    for (; tail != head; tail++) {
+        const LeaderboardPost* post = &lb_queue[tail & (LB_QUEUE_SIZE - 1)];
+        batch[n] = post->entry; survival[n++] = post->survival;
+        sketches_add(io_sketches, post->entry.score, post->survival);
+        if (n == 64) { leaderboard_io_write(batch, survival, n); n = 0; }
+    }
+    if (n > 0) leaderboard_io_write(batch, survival, n);
+    atomic_store_explicit(&lb_tail, tail, memory_order_release);
+    quantile_sketch_save(path_sketch, io_sketches, SKETCH_COUNT);
+}
+
+static void* leaderboard_io_main(void* arg) {
+    (void)arg;
+    struct timespec interval = { 0, LB_IO_INTERVAL_NS };
+    while (!atomic_load_explicit(&lb_stop, memory_order_acquire)) {
+        nanosleep(&interval, NULL);
+        leaderboard_io_drain();
+        if (pending_count >= LB_COMPACT_RECORDS || (pending_count > 0 && time(NULL) - last_compaction >= LB_COMPACT_SECONDS)) compact_journal();
+    }
+    leaderboard_io_drain();
+    // Serveru se daje kratko vreme da potvrdi poslednje rezultate
+    for (int i = 0; i < LB_STOP_ACK_WAIT && lb_client_connected() && lb_client_inflight() > 0; i++) {
+        nanosleep(&interval, NULL);
+        if (!lb_client_poll()) server_fallback();
+    }
+    if (lb_client_inflight() > 0) server_fallback();
+    lb_client_close(NULL, 0);
+    compact_journal();
+    return NULL;
+}
+
+// Istorija je na serveru, pa se tabela posle restarta dopunjava njegovim prvih LEADERBOARD_SIZE
+// (zapis koji vec postoji lokalno, npr. iz zajednickog fajla, se ne duplira)
+void leaderboard_use_server(const char* path) {
+    server_path = path; last_connect_attempt = 0;
+    LeaderboardEntry top[LEADERBOARD_SIZE];
+    int n = lb_client_fetch_top(path, top, LEADERBOARD_SIZE);
+    for (int i = 0; i < n; i++) {
+        int known = 0;
+        for (int j = 0; j < leaderboard_count && !known; j++) known = leaderboard[j].score == top[i].score && leaderboard[j].epoch_time == top[i].epoch_time;
+        if (!known) insert_sorted(leaderboard, &leaderboard_count, top[i]);
+    }
+}
+
+// --- Serverska strana ---
+void leaderboard_commit_batch(const LeaderboardEntry* entries, const float* survival, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        insert_sorted(leaderboard, &leaderboard_count, entries[i]);
+        score_index_add(&score_index, entries[i].score, 1);
+        sketches_add(leaderboard_sketches, entries[i].score, survival[i]);
+    }
+    journal_append(entries, n);
+}
+
+void leaderboard_compact() {
+    compact_journal();
+    quantile_sketch_save(path_sketch, leaderboard_sketches, SKETCH_COUNT);
+}
+
+size_t leaderboard_journal_pending() { return pending_count; }
+
+// Pozadinska kompakcija: nit dobija pending niz i kopiju sketch-eva, a petlja
+// servera nastavlja da dopisuje u zurnal u novi pending. Snimak i sketch fajl
+// dira samo ova nit dok radi; zurnal samo petlja.
+static pthread_t compact_thread;
+static atomic_int compact_state;    // 0 nista, 1 radi, 2 gotovo (ceka poll)
+static int compact_threaded = 0, compact_ok = 0;
+static JournalRecord* compact_records = NULL;
+static size_t compact_count = 0;
+static uint32_t compact_seq = 0;
+static QuantileSketch compact_sketches[SKETCH_COUNT];
+
+static void* compact_main(void* arg) {
+    (void)arg;
+    compact_ok = runs_append(compact_records, compact_count, compact_seq);
+    quantile_sketch_save(path_sketch, compact_sketches, SKETCH_COUNT);
+    atomic_store(&compact_state, 2);
+    return NULL;
+}
+
+// Zurnal posle pozadinske kompakcije: ostaju samo zapisi pristigli u medjuvremenu
+// (temp + fsync + rename, pa pad usred prepisa ostavlja stari, jos ispravan zurnal)
+static void journal_rewrite_tail() {
+    char tmp[LB_PATH_MAX + 4];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path_journal);
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return;
+    size_t size = pending_count * sizeof(JournalRecord);
+    int ok = (size == 0 || write(fd, pending, size) == (ssize_t)size) && fsync(fd) == 0;
+    close(fd);
+    if (!ok || rename(tmp, path_journal) != 0) { remove(tmp); return; }
+    if (journal_fd >= 0) close(journal_fd);
+    journal_fd = -1;
+}
+
+int leaderboard_compact_start() {
+    last_compaction = time(NULL);
+    if (atomic_load(&compact_state) != 0 || pending_count == 0) return 0;
+    compact_seq = pending_max_seq();
+    compact_records = pending; compact_count = pending_count;
+    pending = NULL; pending_count = pending_cap = 0;
+    memcpy(compact_sketches, leaderboard_sketches, sizeof(compact_sketches));
+    atomic_store(&compact_state, 1);
+    compact_threaded = pthread_create(&compact_thread, NULL, compact_main, NULL) == 0;
+    if (!compact_threaded) compact_main(NULL);
+    return 1;
+}
+
+int leaderboard_compact_poll(int wait) {
+    int state = atomic_load(&compact_state);
+    if (state == 0 || (state == 1 && !wait)) return 0;
+    if (compact_threaded) pthread_join(compact_thread, NULL);
+    if (compact_ok) { folded_seq = compact_seq; journal_rewrite_tail(); }
+    else for (size_t i = 0; i < compact_count; i++) pending_push(compact_records[i]);   // zapisi ostaju za sledeci pokusaj
+    free(compact_records); compact_records = NULL; compact_count = 0;
+    atomic_store(&compact_state, 0);
+    return 1;
+}
+
+void leaderboard_io_start() {
+    if (lb_thread_running) return;
+    last_compaction = time(NULL);
+    memcpy(io_sketches, leaderboard_sketches, sizeof(io_sketches));
+    atomic_store(&lb_stop, 0);
+    if (pthread_create(&lb_thread, NULL, leaderboard_io_main, NULL) == 0) lb_thread_running = 1;
+}
+
+void leaderboard_io_stop() {
+    if (!lb_thread_running) return;
+    atomic_store_explicit(&lb_stop, 1, memory_order_release);
+    pthread_join(lb_thread, NULL);
+    lb_thread_running = 0;
+    if (journal_fd >= 0) { close(journal_fd); journal_fd = -1; }
+    if (lb_dropped > 0) { fprintf(stderr, "Leaderboard: %lu rezultata nije stiglo u red za upis\n", lb_dropped); }
+}
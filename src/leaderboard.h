@@ -0,0 +1,134 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "quantile.h"
+#include "score_index.h"
+
+#define LEADERBOARD_SIZE 100
+#define LEADERBOARD_BIN "leaderboard.bin"
+#define LEADERBOARD_JOURNAL "leaderboard.journal"
+#define LEADERBOARD_TXT "leaderboard.txt"
+#define LEADERBOARD_SKETCH "leaderboard.sketch"
+// Shardovi profila: LEADERBOARD_DIR/<ime>.bin, .journal, .sketch
+#define LEADERBOARD_DIR "leaderboards"
+#define LEADERBOARD_PROFILE_MAX 32
+
+// --- Binarni format leaderboard-a ---
+// Run: [LeaderboardHeader][count x LeaderboardEntry][hist_count x ScoreCount],
+// rezultati sortirani opadajuce. Zapis je spakovan (12 bajtova) i identican
+// u memoriji i na disku, pa se ucitavanje svodi na mmap + memcpy. Vreme se
+// cuva kao epoch sekunde, a u tekst se formatira tek pri prikazu. Redosled
+// bajtova je lokalni (LE na svim nasim platformama). Histogram (rezultat,
+// broj igara) puni indeks plasmana bez prolaza kroz sve igre.
+//
+// Istorija sharda je u najvise LEADERBOARD_RUNS run-ova (LSM): <bin> je
+// najstariji i najveci, <bin>.1, <bin>.2, ... sve manji i noviji. Kompakcija
+// upisuje samo novi rep kao run i spaja ga sa novijim run-ovima dok nisu
+// bar LEADERBOARD_RUN_FACTOR puta veci od njega, pa se cela istorija ne
+// prepisuje pri svakoj kompakciji. Run pokriva generacije [gen_lo, gen_hi];
+// run ciji opseg pokriva siri run je zamenjen (pad izmedju rename-a spojenog
+// i brisanja starih) i ne cita se.
+//
+// Zurnal: niz JournalRecord zapisa, jedan po zavrsenoj igri, samo se dopisuje.
+// Pozadinski kompaktor ih periodicno utapa u run-ove; folded_seq u zaglavlju
+// kaze dokle je zurnal vec utopljen, pa pad izmedju rename-a run-a i
+// praznjenja zurnala ne pravi duplikate.
+#define LEADERBOARD_MAGIC "SBLB"
+#define LEADERBOARD_VERSION 3
+#define LEADERBOARD_HEADER_V1_SIZE 16
+#define LEADERBOARD_HEADER_V2_SIZE 24
+#define LEADERBOARD_RUNS 16
+#define LEADERBOARD_RUN_FACTOR 4
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t record_size;
+    uint32_t folded_seq;   // od verzije 2
+    uint32_t gen_lo;       // od verzije 3 (ranije rezervisano, 0)
+    uint32_t gen_hi;       // od verzije 3
+    uint32_t hist_count;   // od verzije 3
+} LeaderboardHeader;
+
+typedef struct { int32_t score; uint32_t count; } ScoreCount;
+
+#pragma pack(push, 1)
+typedef struct { int32_t score; int64_t epoch_time; } LeaderboardEntry;
+typedef struct { uint32_t seq; int32_t score; int64_t epoch_time; } JournalRecord;
+#pragma pack(pop)
+
+_Static_assert(sizeof(LeaderboardEntry) == 12, "LeaderboardEntry mora imati 12 bajtova");
+_Static_assert(sizeof(JournalRecord) == 16, "JournalRecord mora imati 16 bajtova");
+
+// Najboljih LEADERBOARD_SIZE za prikaz; kompletna istorija je na disku
+extern LeaderboardEntry leaderboard[LEADERBOARD_SIZE];
+extern int leaderboard_count;
+// Sve igre ikad (snimak + zurnal), za plasman "#N od M" bez citanja diska
+extern ScoreIndex score_index;
+
+// --- Percentili ---
+// KLL sketch-evi konacnih rezultata i vremena prezivljavanja svih igara,
+// cuvaju se u LEADERBOARD_SKETCH pored leaderboard-a (vidi tools/sketch_tool.c)
+enum { SKETCH_SCORE, SKETCH_SURVIVAL, SKETCH_COUNT };
+extern QuantileSketch leaderboard_sketches[SKETCH_COUNT];
+// p50/p90/p99 za dati sketch; 0 ako jos nema podataka
+int leaderboard_percentiles(int which, float out[3]);
+
+// --- Profili ---
+// Svaki profil ima svoj shard, pa kiosci/igraci ne dele isti fajl. Bez profila
+// se koriste globalni fajlovi iz radnog direktorijuma (i migracija leaderboard.txt).
+// Poziva se pre load_leaderboard; ime sme imati samo [A-Za-z0-9_-]. 0 ako ime nije ispravno.
+int leaderboard_set_profile(const char* name);
+const char* leaderboard_profile();   // "" za globalni
+// Najboljih n iz svih shardova (globalni fajl + LEADERBOARD_DIR/*.bin, sa neutopljenim
+// zurnalima), k-way spajanjem vec sortiranih run-ova; u klijentskom rezimu tabela servera.
+// Cita disk ili socket; ne zvati sa frejm niti.
+int leaderboard_global_top(LeaderboardEntry* out, int n);
+
+void load_leaderboard();
+// Azurira leaderboard u memoriji odmah; upis na disk radi I/O nit ako je pokrenuta
+void add_score_to_leaderboard(int new_score, float survival_seconds);
+void print_full_leaderboard();
+// Uvozi tekstualni fajl (format leaderboard.txt) u istoriju, pre leaderboard_io_start.
+// Vraca broj uvezenih rezultata ili -1. Vreme prezivljavanja nije poznato, pa se azurira samo sketch rezultata.
+long leaderboard_import_text(const char* path);
+// "YYYY-MM-DD HH:MM:SS" u lokalnom vremenu; buf mora imati bar 30 bajtova
+void format_timestamp(int64_t epoch_time, char* buf);
+
+// --- Pozadinski upis ---
+// Nit preuzima nove rezultate iz lock-free reda, sve pristigle od poslednjeg
+// budjenja dopisuje u zurnal jednim write + fsync, i povremeno radi
+// kompakciju (temp + fsync + rename). Frejm nit nikad ne dira fajl sistem
+// dok nit radi.
+void leaderboard_io_start();
+// Ceka da se red isprazni, utapa zurnal u snimak i gasi nit (bezbedno vise puta)
+void leaderboard_io_stop();
+// Klijentski rezim (pozvati pre leaderboard_io_start): I/O nit salje rezultate
+// leaderboard serveru na datom Unix socketu (vidi tools/leaderboard_server.c),
+// a lokalni zurnal koristi samo dok server nije dostupan. Tabela se odmah
+// dopunjava prvim rezultatima sa servera (blokira do ~1 s), a globalni
+// pregled cita serversku tabelu.
+void leaderboard_use_server(const char* path);
+// Plasman (medju svim igrama na serveru) poslednjeg rezultata koji je server
+// potvrdio; 1 ako je stigla nova potvrda od proslog poziva. Za frejm nit.
+int leaderboard_server_rank(int32_t* score, uint64_t* rank, uint64_t* total);
+
+// --- Za leaderboard server (bez I/O niti) ---
+// Grupni commit: azurira memoriju i dopisuje sve zapise u zurnal jednim write + fsync
+void leaderboard_commit_batch(const LeaderboardEntry* entries, const float* survival, size_t n);
+// Utapa zurnal u snimak i snima sketch-eve
+void leaderboard_compact();
+// Broj zapisa u zurnalu koji jos nisu utopljeni (bez onih koje upravo utapa pozadinska kompakcija)
+size_t leaderboard_journal_pending();
+// Kompakcija na pozadinskoj niti, da spajanje snimka i fsync ne koce petlju
+// servera; commit_batch se sme zvati dok radi. 0 ako vec radi ili nema sta da se utapa.
+int leaderboard_compact_start();
+// Zavrsava kompakciju sa start (wait: ceka nit): skracuje zurnal na zapise
+// pristigle u medjuvremenu. 1 ako je kompakcija zavrsena ovim pozivom.
+int leaderboard_compact_poll(int wait);
+
+#endif
@@ -0,0 +1,139 @@
+#define _POSIX_C_SOURCE 200809L
+#include "leaderboard_client.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "leaderboard_proto.h"
+
+#ifdef MSG_NOSIGNAL
+#define LB_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define LB_SEND_FLAGS 0   // macOS: SO_NOSIGPIPE na socketu
+#endif
+
+#define LB_INFLIGHT 1024  // stepen dvojke
+
+static int client_fd = -1;
+// Poslati (ili u izlaznom baferu) a jos nepotvrdjeni rezultati, redom slanja
+static LeaderboardEntry inflight[LB_INFLIGHT];
+static unsigned inflight_head = 0, inflight_tail = 0;
+static unsigned char out_buf[LB_INFLIGHT * sizeof(LbRequest)];
+static size_t out_len = 0;
+static unsigned char in_buf[64 * sizeof(LbReply)];
+static size_t in_len = 0;
+// Poslednja potvrda SUBMIT-a (plasman medju svim igrama na serveru)
+static LeaderboardEntry ack_entry;
+static uint64_t ack_rank = 0, ack_total = 0;
+static int ack_fresh = 0;
+
+static int open_socket(const char* path) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    strcpy(addr.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0); if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); return -1; }
+#ifdef SO_NOSIGPIPE
+    int one = 1; setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    return fd;
+}
+
+int lb_client_connect(const char* path) {
+    if (client_fd >= 0) return 1;
+    int fd = open_socket(path); if (fd < 0) return 0;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    client_fd = fd;
+    inflight_head = inflight_tail = 0; out_len = in_len = 0;
+    return 1;
+}
+
+int lb_client_connected() { return client_fd >= 0; }
+size_t lb_client_inflight() { return inflight_head - inflight_tail; }
+
+static int flush_out() {
+    while (out_len > 0) {
+        ssize_t w = send(client_fd, out_buf, out_len, LB_SEND_FLAGS);
+        if (w < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        memmove(out_buf, out_buf + w, out_len - (size_t)w);
+        out_len -= (size_t)w;
+    }
+    return 1;
+}
+
+size_t lb_client_submit(const LeaderboardEntry* entries, const float* survival, size_t n) {
+    if (client_fd < 0) return 0;
+    size_t sent = 0;
+    for (; sent < n && inflight_head - inflight_tail < LB_INFLIGHT; sent++) {
+        LbRequest r = { .op = LB_OP_SUBMIT, .score = entries[sent].score, .epoch_time = entries[sent].epoch_time, .survival = survival[sent] };
+        memcpy(out_buf + out_len, &r, sizeof(r)); out_len += sizeof(r);
+        inflight[inflight_head++ & (LB_INFLIGHT - 1)] = entries[sent];
+    }
+    flush_out();
+    return sent;
+}
+
+int lb_client_poll() {
+    if (client_fd < 0) return 0;
+    if (!flush_out()) return 0;
+    for (;;) {
+        ssize_t r = recv(client_fd, in_buf + in_len, sizeof(in_buf) - in_len, 0);
+        if (r == 0) return 0;
+        if (r < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        in_len += (size_t)r;
+        size_t used = 0;
+        for (; in_len - used >= sizeof(LbReply); used += sizeof(LbReply)) {
+            LbReply reply; memcpy(&reply, in_buf + used, sizeof(reply));
+            if (reply.op != LB_OP_SUBMIT || inflight_tail == inflight_head) continue;
+            ack_entry = inflight[inflight_tail++ & (LB_INFLIGHT - 1)];
+            ack_rank = reply.rank; ack_total = reply.total; ack_fresh = 1;
+        }
+        memmove(in_buf, in_buf + used, in_len - used);
+        in_len -= used;
+    }
+}
+
+int lb_client_take_ack(LeaderboardEntry* e, uint64_t* rank, uint64_t* total) {
+    if (!ack_fresh) return 0;
+    *e = ack_entry; *rank = ack_rank; *total = ack_total;
+    ack_fresh = 0;
+    return 1;
+}
+
+size_t lb_client_close(LeaderboardEntry* out, size_t cap) {
+    size_t n = 0;
+    for (; inflight_tail != inflight_head && n < cap; inflight_tail++) out[n++] = inflight[inflight_tail & (LB_INFLIGHT - 1)];
+    if (client_fd >= 0) { close(client_fd); client_fd = -1; }
+    out_len = in_len = 0;
+    return n;
+}
+
+static int read_full(int fd, void* buf, size_t len) {
+    for (size_t got = 0; got < len; ) {
+        ssize_t r = recv(fd, (unsigned char*)buf + got, len - got, 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return 0;
+        got += (size_t)r;
+    }
+    return 1;
+}
+
+int lb_client_fetch_top(const char* path, LeaderboardEntry* out, int n) {
+    int fd = open_socket(path); if (fd < 0) return -1;
+    struct timeval timeout = { 1, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    LbRequest r = { .op = LB_OP_TOP, .arg = (uint32_t)n };
+    LbReply reply;
+    int got = -1;
+    if (send(fd, &r, sizeof(r), LB_SEND_FLAGS) == (ssize_t)sizeof(r) && read_full(fd, &reply, sizeof(reply)) &&
+        reply.op == LB_OP_TOP && reply.count <= (uint32_t)n && read_full(fd, out, reply.count * sizeof(LeaderboardEntry)))
+        got = (int)reply.count;
+    close(fd);
+    return got;
+}
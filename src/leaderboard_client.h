@@ -0,0 +1,29 @@
+#ifndef LEADERBOARD_CLIENT_H
+#define LEADERBOARD_CLIENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "leaderboard.h"
+
+// --- Klijent leaderboard servera ---
+// Koristi ga samo I/O nit leaderboard-a. Slanje je neblokirajuce: rezultati
+// se pamte dok server ne potvrdi da su trajno upisani, a ako veza pukne,
+// nepotvrdjeni se vracaju pozivaocu da ih upise u lokalni zurnal.
+
+int lb_client_connect(const char* path);
+int lb_client_connected();
+// Salje n rezultata; vraca koliko je poslato (ostatak ide lokalno)
+size_t lb_client_submit(const LeaderboardEntry* entries, const float* survival, size_t n);
+// Broj poslatih rezultata koji cekaju potvrdu
+size_t lb_client_inflight();
+// Cita pristigle potvrde; vraca 0 ako je veza pukla
+int lb_client_poll();
+// Poslednji potvrdjen rezultat i njegov plasman na serveru; 1 ako je stigla nova potvrda od proslog poziva
+int lb_client_take_ack(LeaderboardEntry* e, uint64_t* rank, uint64_t* total);
+// Zatvara vezu i vadi do cap nepotvrdjenih rezultata u out; zove se dok ne vrati 0
+size_t lb_client_close(LeaderboardEntry* out, size_t cap);
+// Zasebna, blokirajuca veza (do ~1 s): prvih najvise n rezultata sa servera; -1 ako server nije dostupan
+int lb_client_fetch_top(const char* path, LeaderboardEntry* out, int n);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef LEADERBOARD_PROTO_H
+#define LEADERBOARD_PROTO_H
+
+#include <stdint.h>
+
+#include "leaderboard.h"
+
+// --- Protokol leaderboard servera ---
+// Unix domain stream socket, poruke fiksne duzine u lokalnom redosledu bajtova
+// (klijent i server su uvek na istoj masini). Klijent salje LbRequest, server
+// odgovara jednim LbReply po zahtevu, redom kojim su stigli na tu vezu:
+//   SUBMIT - odgovor tek posle fsync-a grupe u koju je rezultat upao (rank/total)
+//   RANK   - plasman rezultata `score` medju svim igrama (bez upisa)
+// RANK/TOP iza nepotvrdjenog SUBMIT-a iste veze cekaju isti commit, pa vide taj rezultat.
+//   TOP    - prvih `arg` (najvise LEADERBOARD_SIZE) rezultata; iza odgovora sledi count x LeaderboardEntry
+#define LB_SERVER_SOCKET "/tmp/svemirski_begunac.sock"
+
+enum { LB_OP_SUBMIT = 1, LB_OP_RANK = 2, LB_OP_TOP = 3 };
+
+typedef struct {
+    uint32_t op;
+    int32_t score;
+    int64_t epoch_time;
+    float survival;
+    uint32_t arg;
+} LbRequest;
+
+typedef struct {
+    uint32_t op;
+    uint32_t count;     // broj LeaderboardEntry iza odgovora (samo TOP)
+    uint64_t rank;
+    uint64_t total;
+} LbReply;
+
+_Static_assert(sizeof(LbRequest) == 24, "LbRequest mora imati 24 bajta");
+_Static_assert(sizeof(LbReply) == 24, "LbReply mora imati 24 bajta");
+
+#endif
@@ -0,0 +1,138 @@
+#define _POSIX_C_SOURCE 200809L
+#include "leaderboard_text.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Pozicija prvog '\n' u [p, end) ili end; 16 bajtova po koraku gde ima SIMD-a
+static const char* find_newline(const char* p, const char* end) {
+#if defined(__SSE2__)
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+        if (mask) return p + __builtin_ctz((unsigned)mask);
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t nl = vdupq_n_u8('\n');
+    for (; end - p >= 16; p += 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8((const uint8_t*)p), nl);
+        // Suzavanje na 4 bita po bajtu daje 64-bitnu masku (NEON nema movemask)
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        if (mask) return p + (__builtin_ctzll(mask) >> 2);
+    }
+#else
+    // SWAR: 8 bajtova odjednom
+    for (; end - p >= 8; p += 8) {
+        uint64_t w; memcpy(&w, p, 8);
+        uint64_t x = w ^ 0x0A0A0A0A0A0A0A0AULL;
+        uint64_t hit = (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+        if (hit) return p + (__builtin_ctzll(hit) >> 3);
+    }
+#endif
+    while (p < end && *p != '\n') p++;
+    return p;
+}
+
+size_t text_count_newlines(const char* data, size_t len) {
+    size_t n = 0;
+    const char* end = data + len;
+    for (const char* p = find_newline(data, end); p < end; p = find_newline(p + 1, end)) n++;
+    return n;
+}
+
+static inline int digit_at(const char* p, int i) { return (unsigned)(p[i] - '0') <= 9 ? p[i] - '0' : -1; }
+static inline int two_digits(const char* p, int i) { int a = digit_at(p, i), b = digit_at(p, i + 1); return (a < 0 || b < 0) ? -1 : a * 10 + b; }
+
+// Dani od 1970-01-01 za proleptic gregorijanski kalendar (Howard Hinnant)
+static int64_t days_from_civil(int y, int m, int d) {
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153u * (unsigned)(m + (m > 2 ? -3 : 9)) + 2) / 5 + (unsigned)d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+typedef struct { int64_t day; int64_t offset; int uniform; } TzCache;
+
+static int64_t tz_offset(int y, int mo, int d, int h, int mi, int s, int64_t naive) {
+    struct tm tm_info = { .tm_year = y - 1900, .tm_mon = mo - 1, .tm_mday = d, .tm_hour = h, .tm_min = mi, .tm_sec = s, .tm_isdst = -1 };
+    return naive - (int64_t)mktime(&tm_info);
+}
+
+// Lokalno vreme -> epoch; mktime jednom po danu, osim na dan promene letnjeg racunanja vremena
+static int64_t local_to_epoch(TzCache* tz, int y, int mo, int d, int h, int mi, int s) {
+    int64_t day = days_from_civil(y, mo, d);
+    int64_t naive = day * 86400 + h * 3600 + mi * 60 + s;
+    if (day != tz->day) {
+        tz->day = day;
+        tz->offset = tz_offset(y, mo, d, 0, 0, 0, day * 86400);
+        tz->uniform = tz->offset == tz_offset(y, mo, d, 23, 59, 59, day * 86400 + 86399);
+    }
+    return tz->uniform ? naive - tz->offset : naive - tz_offset(y, mo, d, h, mi, s, naive);
+}
+
+// Jedna linija [p, end) bez '\n'; 1 ako je ispravna
+static int parse_line(const char* p, const char* end, TzCache* tz, LeaderboardEntry* e) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    int neg = 0;
+    if (p < end && *p == '-') { neg = 1; p++; }
+    if (p >= end || (unsigned)(*p - '0') > 9) return 0;
+    int64_t score = 0;
+    while (p < end && (unsigned)(*p - '0') <= 9) { score = score * 10 + (*p - '0'); if (score > INT32_MAX) return 0; p++; }
+    while (p < end && *p == ' ') p++;
+    // YYYY-MM-DD HH:MM:SS (19 znakova), opciono '\r' na kraju
+    if (end - p < 19 || p[4] != '-' || p[7] != '-' || p[10] != ' ' || p[13] != ':' || p[16] != ':') return 0;
+    int y1 = two_digits(p, 0), y2 = two_digits(p, 2), mo = two_digits(p, 5), d = two_digits(p, 8);
+    int h = two_digits(p, 11), mi = two_digits(p, 14), s = two_digits(p, 17);
+    if (y1 < 0 || y2 < 0 || mo < 1 || mo > 12 || d < 1 || d > 31 || h < 0 || h > 23 || mi < 0 || mi > 59 || s < 0 || s > 60) return 0;
+    e->score = (int32_t)(neg ? -score : score);
+    e->epoch_time = local_to_epoch(tz, y1 * 100 + y2, mo, d, h, mi, s);
+    return 1;
+}
+
+size_t leaderboard_parse_text(const char* data, size_t len, LeaderboardEntry* out, size_t cap, size_t* skipped) {
+    TzCache tz = { INT64_MIN, 0, 0 };
+    const char* p = data;
+    const char* end = data + len;
+    size_t n = 0, bad = 0;
+    while (p < end && n < cap) {
+        const char* nl = find_newline(p, end);
+        if (nl > p) { if (parse_line(p, nl, &tz, &out[n])) n++; else bad++; }
+        p = nl + 1;
+    }
+    if (skipped != NULL) *skipped = bad;
+    return n;
+}
+
+long leaderboard_read_text_file(const char* path, LeaderboardEntry** out, size_t* skipped) {
+    *out = NULL;
+    if (skipped != NULL) *skipped = 0;
+    int fd = open(path, O_RDONLY); if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(fd); return -1; }
+    if (st.st_size == 0) { close(fd); return 0; }
+    size_t len = (size_t)st.st_size;
+    void* map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    posix_madvise(map, len, POSIX_MADV_SEQUENTIAL);
+    // +1 za poslednju liniju bez '\n'
+    size_t cap = text_count_newlines(map, len) + 1;
+    *out = malloc(cap * sizeof(LeaderboardEntry));
+    size_t n = (*out != NULL) ? leaderboard_parse_text(map, len, *out, cap, skipped) : 0;
+    munmap(map, len);
+    return (long)n;
+}
@@ -0,0 +1,21 @@
+#ifndef LEADERBOARD_TEXT_H
+#define LEADERBOARD_TEXT_H
+
+#include <stddef.h>
+
+#include "leaderboard.h"
+
+// --- Brzi parser tekstualnog leaderboard-a ---
+// Format je stari leaderboard.txt: "score YYYY-MM-DD HH:MM:SS" po liniji.
+// Fajl se mapira (mmap) i parsira na licu mesta, bez kopiranja linija:
+// SIMD trazenje '\n', rucno parsiranje broja i datuma bez sscanf/mktime
+// (lokalna vremenska zona se racuna jednom po danu). Neispravne linije se preskacu.
+
+// Broj '\n' u baferu (za unapred alociran izlaz)
+size_t text_count_newlines(const char* data, size_t len);
+// Parsira bafer u `out` (najvise cap zapisa); vraca broj ispravnih zapisa
+size_t leaderboard_parse_text(const char* data, size_t len, LeaderboardEntry* out, size_t cap, size_t* skipped);
+// mmap + parsiranje celog fajla; *out se alocira (malloc) i oslobadja pozivalac. -1 ako fajl ne moze da se otvori.
+long leaderboard_read_text_file(const char* path, LeaderboardEntry** out, size_t* skipped);
+
+#endif
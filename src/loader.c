@@ -0,0 +1,83 @@
+#define _POSIX_C_SOURCE 200809L
+#include "loader.h"
+#include "arena.h"
+#include "trace.h"
+
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
+
+static pthread_t loader_thread;
+static pthread_mutex_t loader_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loader_cond = PTHREAD_COND_INITIALIZER;   // novi zadatak ili zavrsen zadatak
+static LoadTask* queue_head = NULL;
+static LoadTask* queue_tail = NULL;
+static int loader_running = 0, loader_stopping = 0;
+
+// Privremena memorija zadataka (thread_arena loader niti); vraca se posle svakog zadatka
+#define LOADER_ARENA_SIZE (1u << 20)
+static Arena loader_arena;
+
+static double now_seconds() { struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return t.tv_sec + t.tv_nsec / 1e9; }
+
+static void run_task(LoadTask* t) {
+    double t0 = now_seconds();
+    TRACE_ZONE(t->name);
+    // Bez loader niti zadatak radi na pozivaocu, pa i njegova arena ima tacku povratka
+    size_t mark = thread_arena != NULL ? arena_mark(thread_arena) : 0;
+    t->run(t->arg);
+    if (thread_arena != NULL) arena_rewind(thread_arena, mark);
+    t->seconds = now_seconds() - t0;
+    atomic_store_explicit(&t->done, 1, memory_order_release);
+}
+
+static void* loader_main(void* arg) {
+    (void)arg;
+    TRACE_THREAD("loader");
+    if (arena_init(&loader_arena, LOADER_ARENA_SIZE)) thread_arena = &loader_arena;
+    pthread_mutex_lock(&loader_mutex);
+    for (;;) {
+        while (queue_head == NULL && !loader_stopping) pthread_cond_wait(&loader_cond, &loader_mutex);
+        if (queue_head == NULL) break;
+        LoadTask* t = queue_head;
+        queue_head = t->next;
+        if (queue_head == NULL) queue_tail = NULL;
+        pthread_mutex_unlock(&loader_mutex);
+        run_task(t);
+        pthread_mutex_lock(&loader_mutex);
+        pthread_cond_broadcast(&loader_cond);
+    }
+    pthread_mutex_unlock(&loader_mutex);
+    thread_arena = NULL;
+    arena_destroy(&loader_arena);
+    return NULL;
+}
+
+void loader_submit(LoadTask* t) {
+    atomic_store(&t->done, 0);
+    t->next = NULL;
+    pthread_mutex_lock(&loader_mutex);
+    if (!loader_running && !loader_stopping && pthread_create(&loader_thread, NULL, loader_main, NULL) == 0) loader_running = 1;
+    if (!loader_running) { pthread_mutex_unlock(&loader_mutex); run_task(t); return; }
+    if (queue_tail != NULL) queue_tail->next = t; else queue_head = t;
+    queue_tail = t;
+    pthread_cond_broadcast(&loader_cond);
+    pthread_mutex_unlock(&loader_mutex);
+}
+
+void loader_wait(LoadTask* t) {
+    if (loader_done(t)) return;
+    pthread_mutex_lock(&loader_mutex);
+    while (!loader_done(t)) pthread_cond_wait(&loader_cond, &loader_mutex);
+    pthread_mutex_unlock(&loader_mutex);
+}
+
+void loader_shutdown() {
+    pthread_mutex_lock(&loader_mutex);
+    int running = loader_running;
+    loader_stopping = 1;
+    pthread_cond_broadcast(&loader_cond);
+    pthread_mutex_unlock(&loader_mutex);
+    if (running) pthread_join(loader_thread, NULL);
+    loader_running = 0;
+}
@@ -0,0 +1,29 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <stdatomic.h>
+
+// --- Loader nit ---
+// Sporo ucitavanje pri startu (leaderboard, kasnije i drugi resursi) radi se
+// na jednoj pozadinskoj niti dok se prozor, sejderi i prvi frejmovi dizu.
+// Zadaci se izvrsavaju redom kojim su predati. Frejm nit proverava
+// loader_done bez blokiranja, a loader_wait zove tek kad joj rezultat zaista treba.
+typedef struct LoadTask {
+    const char* name;
+    void (*run)(void* arg);
+    void* arg;
+    atomic_int done;
+    double seconds;          // trajanje run(), vazi kad je done
+    struct LoadTask* next;
+} LoadTask;
+
+#define LOAD_TASK(task_name, fn, task_arg) ((LoadTask){ .name = (task_name), .run = (fn), .arg = (task_arg) })
+
+// Predaje zadatak; nit se pokrece pri prvom pozivu. Bez niti zadatak se izvrsi odmah.
+void loader_submit(LoadTask* t);
+static inline int loader_done(LoadTask* t) { return atomic_load_explicit(&t->done, memory_order_acquire); }
+void loader_wait(LoadTask* t);
+// Ceka sve predate zadatke i gasi nit
+void loader_shutdown();
+
+#endif
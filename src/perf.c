@@ -0,0 +1,48 @@
+#include "perf.h"
+
+#include <string.h>
+
+_Static_assert((FRAME_RING_SIZE & (FRAME_RING_SIZE - 1)) == 0, "FRAME_RING_SIZE mora biti stepen dvojke");
+
+void frame_ring_push(FrameRing* r, const float phase_ms[PHASE_COUNT]) {
+    uint32_t slot = r->head & (FRAME_RING_SIZE - 1);
+    float total = 0.0f;
+    for (int p = 0; p < PHASE_COUNT; p++) { r->ms[p][slot] = phase_ms[p]; total += phase_ms[p]; }
+    r->ms[PHASE_TOTAL][slot] = total;
+    r->head++;
+    if (r->count < FRAME_RING_SIZE) r->count++;
+}
+
+// k-ti najmanji (0-based); delimicno preuredjuje a[0..n)
+static float select_kth(float* a, uint32_t n, uint32_t k) {
+    uint32_t lo = 0, hi = n - 1;
+    while (lo < hi) {
+        float pivot = a[lo + (hi - lo) / 2];
+        uint32_t i = lo, j = hi;
+        while (i <= j) {
+            while (a[i] < pivot) i++;
+            while (a[j] > pivot) j--;
+            if (i <= j) { float t = a[i]; a[i] = a[j]; a[j] = t; i++; if (j == 0) break; j--; }
+        }
+        if (k <= j) hi = j;
+        else if (k >= i) lo = i;
+        else return a[k];
+    }
+    return a[k];
+}
+
+void frame_ring_percentiles(const FrameRing* r, int phase, float* scratch, FramePercentiles* out) {
+    *out = (FramePercentiles){0};
+    uint32_t n = r->count;
+    if (n == 0) return;
+    // Prsten je pun ili popunjen od pocetka, pa je prvih n slotova uvek validno
+    memcpy(scratch, r->ms[phase], n * sizeof(float));
+    // Vece k posle manjeg: elementi iznad k ostaju iznad, pa svaki sledeci select radi nad repom
+    uint32_t k50 = (n - 1) / 2, k95 = (uint32_t)(0.95f * (n - 1)), k99 = (uint32_t)(0.99f * (n - 1));
+    out->p50 = select_kth(scratch, n, k50);
+    out->p95 = k95 > k50 ? select_kth(scratch + k50 + 1, n - k50 - 1, k95 - k50 - 1) : out->p50;
+    out->p99 = k99 > k95 ? select_kth(scratch + k95 + 1, n - k95 - 1, k99 - k95 - 1) : out->p95;
+    float mx = 0.0f;
+    for (uint32_t i = k99; i < n; i++) if (scratch[i] > mx) mx = scratch[i];
+    out->max = mx;
+}
@@ -0,0 +1,28 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+
+// --- Vremena frejmova ---
+// Prsten poslednjih FRAME_RING_SIZE frejmova, podeljenih po fazama glavne
+// petlje. Percentili se racunaju quickselect-om nad kopijom prstena, i to samo
+// kad ih overlay trazi (par puta u sekundi), pa upis po frejmu kosta par float-ova.
+#define FRAME_RING_SIZE 512
+enum { PHASE_INPUT, PHASE_UPDATE, PHASE_RENDER, PHASE_SWAP, PHASE_COUNT, PHASE_TOTAL = PHASE_COUNT };
+
+typedef struct {
+    float ms[PHASE_COUNT + 1][FRAME_RING_SIZE];   // poslednja kolona je zbir faza
+    uint32_t head, count;
+} FrameRing;
+
+typedef struct { float p50, p95, p99, max; } FramePercentiles;
+
+void frame_ring_push(FrameRing* r, const float phase_ms[PHASE_COUNT]);
+// Percentili za jednu fazu ili PHASE_TOTAL; scratch mora imati FRAME_RING_SIZE mesta
+void frame_ring_percentiles(const FrameRing* r, int phase, float* scratch, FramePercentiles* out);
+// Vrednost i-tog frejma unazad (0 = poslednji)
+static inline float frame_ring_recent(const FrameRing* r, int phase, uint32_t i) {
+    return r->ms[phase][(r->head - 1 - i) & (FRAME_RING_SIZE - 1)];
+}
+
+#endif
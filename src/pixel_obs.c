@@ -0,0 +1,97 @@
+#include "pixel_obs.h"
+
+#include <string.h>
+
+#include "collision.h"
+
+typedef struct { uint8_t* out; int w, h, channels; float sx, sy; } Raster;
+
+// Bez poziva libm-a (fminf/ceilf bez -ffast-math i SSE4.1 nisu ugradjeni)
+static inline float min2(float a, float b) { return a < b ? a : b; }
+static inline float max2(float a, float b) { return a > b ? a : b; }
+// Prvi i poslednji ceo broj k sa centrom k + 0.5 u [lo, hi], odseceno na [0, n-1]
+static inline int first_center(float lo) { float v = lo - 0.5f; if (v <= 0.0f) return 0; int k = (int)v; return k + (v > (float)k); }
+static inline int last_center(float hi, int n) { float v = hi - 0.5f; if (v < 0.0f) return -1; int k = (int)v; return k < n - 1 ? k : n - 1; }
+
+static inline uint8_t to_byte(float v) { return v <= 0.0f ? 0 : (v >= 1.0f ? 255 : (uint8_t)(v * 255.0f + 0.5f)); }
+
+static inline void put_pixel(const Raster* r, int x, int y, const uint8_t* c) {
+    uint8_t* p = r->out + ((size_t)y * r->w + x) * r->channels;
+    p[0] = c[0];
+    if (r->channels == 3) { p[1] = c[1]; p[2] = c[2]; }
+}
+
+// Boja u format bafera; siva je Rec. 601 luma u celim brojevima
+static void pack_color(const Raster* r, Vec3 color, uint8_t* c) {
+    c[0] = to_byte(color.r); c[1] = to_byte(color.g); c[2] = to_byte(color.b);
+    if (r->channels == 1) c[0] = (uint8_t)((77 * c[0] + 150 * c[1] + 29 * c[2]) >> 8);
+}
+
+static void fill_shape(const Raster* r, const float* verts, int n, Vec2 pos, Vec2 size, float rotation, Vec3 color) {
+    ConvexPoly p;
+    poly_from_shape(&p, verts, n, pos, size, rotation);
+    // U piksel koordinate (y na dole) i okvir poligona
+    float x0 = 1e30f, x1 = -1e30f, y0 = 1e30f, y1 = -1e30f;
+    for (int i = 0; i < n; i++) {
+        p.x[i] = (p.x[i] + 1.0f) * r->sx;
+        p.y[i] = (1.0f - p.y[i]) * r->sy;
+        x0 = min2(x0, p.x[i]); x1 = max2(x1, p.x[i]);
+        y0 = min2(y0, p.y[i]); y1 = max2(y1, p.y[i]);
+    }
+    if (x1 < 0.0f || y1 < 0.0f || x0 >= r->w || y0 >= r->h) return;
+    uint8_t c[3];
+    pack_color(r, color, c);
+
+    // Ivica i -> j: unutra je strana na kojoj je povrsina pozitivna
+    float area = 0.0f;
+    for (int i = 0; i < n; i++) { int j = (i + 1) % n; area += p.x[i] * p.y[j] - p.x[j] * p.y[i]; }
+    float sign = area >= 0.0f ? 1.0f : -1.0f;
+    // Ivica kao granica po x u redu y: x >= (ili <=) eb*y + ec; horizontalne ivice samo seku redove
+    float eb[POLY_MAX_VERTS], ec[POLY_MAX_VERTS];
+    int side[POLY_MAX_VERTS];   // 1 donja granica, -1 gornja, 0 horizontalna
+    for (int i = 0; i < n; i++) {
+        int j = (i + 1) % n;
+        float a = -(p.y[j] - p.y[i]) * sign, b = (p.x[j] - p.x[i]) * sign, c = -(a * p.x[i] + b * p.y[i]);
+        side[i] = a > 1e-6f ? 1 : (a < -1e-6f ? -1 : 0);
+        if (side[i]) { eb[i] = -b / a; ec[i] = -c / a; } else { eb[i] = b; ec[i] = c; }
+    }
+
+    int row0 = first_center(y0), row1 = last_center(y1, r->h), drawn = 0;
+    for (int y = row0; y <= row1; y++) {
+        float cy = y + 0.5f, lo = x0, hi = x1;
+        for (int i = 0; i < n; i++) {
+            float v = eb[i] * cy + ec[i];
+            if (side[i] > 0) lo = max2(lo, v);
+            else if (side[i] < 0) hi = min2(hi, v);
+            else if (v < 0.0f) hi = -1.0f;   // red je sa spoljne strane horizontalne ivice
+        }
+        int col0 = first_center(lo), col1 = last_center(hi, r->w);
+        for (int x = col0; x <= col1; x++) put_pixel(r, x, y, c);
+        drawn |= col0 <= col1;
+    }
+    if (!drawn) {
+        int x = (int)((pos.x + 1.0f) * r->sx), y = (int)((1.0f - pos.y) * r->sy);
+        if (x >= 0 && x < r->w && y >= 0 && y < r->h) put_pixel(r, x, y, c);
+    }
+}
+
+void pixel_obs_render(const GameState* g, uint8_t* out, int w, int h, int flags) {
+    Raster r = { out, w, h, (flags & PIXEL_OBS_RGB) ? 3 : 1, 0.5f * w, 0.5f * h };
+    memset(out, 0, (size_t)pixel_obs_size(w, h, flags));
+
+    // Zvezde su manje od piksela pri ovoj rezoluciji: jedan piksel svetline sloja
+    if (flags & PIXEL_OBS_STARS) {
+        static const float brightness[NUM_LAYERS] = { 0.3f, 0.6f, 1.0f };
+        uint8_t c[NUM_LAYERS][3];
+        for (int l = 0; l < NUM_LAYERS; l++) pack_color(&r, (Vec3){brightness[l], brightness[l], brightness[l]}, c[l]);
+        for (int i = 0; i < MAX_STARS; i++) {
+            int x = (int)((g->stars.x[i] + 1.0f) * r.sx), y = (int)((1.0f - g->stars.y[i]) * r.sy);
+            if (x >= 0 && x < w && y >= 0 && y < h) put_pixel(&r, x, y, c[g->stars.layer[i]]);
+        }
+    }
+    if (!g->game_over) {
+        FOR_EACH_ASTEROID(g, i) fill_shape(&r, quad_vertices, 4, g->asteroids[i].position, g->asteroids[i].size, g->asteroids[i].rotation, g->asteroids[i].color);
+        FOR_EACH_BULLET(g, i) fill_shape(&r, quad_vertices, 4, g->bullets[i].position, g->bullets[i].size, g->bullets[i].rotation, g->bullets[i].color);
+    }
+    if (g->player_active) fill_shape(&r, player_vertices, 3, g->player.position, g->player.size, g->player.rotation, g->player.color);
+}
@@ -0,0 +1,23 @@
+#ifndef PIXEL_OBS_H
+#define PIXEL_OBS_H
+
+#include <stdint.h>
+
+#include "game.h"
+
+// --- Opservacije u pikselima, rasterizovane na CPU-u ---
+// Crta stanje direktno u mali bafer (npr. 84x84) bez GL-a i bez umanjivanja
+// slike pune rezolucije: isti oblici (quad_vertices, player_vertices) i ista
+// transformacija kao vertex sejder (poly_from_shape), pa se svaki konveksni
+// poligon popunjava red po red (raspon reda iz ivica, test centra piksela).
+// Oblik manji od piksela i dalje pali piksel u kome mu je centar, da metci
+// ne nestanu pri maloj rezoluciji. Redosled je kao u igri: zvezde,
+// asteroidi, metci, igrac. Red 0 je vrh ekrana; svet [-1,1] ispunjava sliku.
+#define PIXEL_OBS_RGB   1   // 3 bajta po pikselu (R,G,B) umesto sive (luma)
+#define PIXEL_OBS_STARS 2   // crtati i zvezde (pozadina); podrazumevano crna
+
+// out: w * h * (1 ili 3) bajtova
+void pixel_obs_render(const GameState* g, uint8_t* out, int w, int h, int flags);
+static inline int pixel_obs_size(int w, int h, int flags) { return w * h * ((flags & PIXEL_OBS_RGB) ? 3 : 1); }
+
+#endif
@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+#include "quantile.h"
+#include "arena.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define QS_MAGIC "SBQS"
+#define QS_VERSION 1
+#define KLL_MIN_CAP 8
+
+void quantile_sketch_init(QuantileSketch* s) {
+    s->n = 0; s->num_levels = 1; s->coin = 0;
+    s->min = INFINITY; s->max = -INFINITY;
+    memset(s->size, 0, sizeof(s->size));
+}
+
+// Kapacitet opada geometrijski (2/3) od najviseg nivoa ka nizim
+static uint32_t level_capacity(const QuantileSketch* s, uint32_t h) {
+    double cap = KLL_K * pow(2.0 / 3.0, (double)(s->num_levels - 1 - h));
+    return cap < KLL_MIN_CAP ? KLL_MIN_CAP : (uint32_t)cap;
+}
+
+static int compare_floats(const void* a, const void* b) { float x = *(const float*)a, y = *(const float*)b; return (x > y) - (x < y); }
+
+// Sortira nivo h i svaki drugi element prenosi na h+1; ako h+1 nema mesta,
+// prvo se on kompaktuje (prenos kao kod sabiranja), pa se nista ne gubi
+static void compact_level(QuantileSketch* s, uint32_t h) {
+    if (h + 1 == s->num_levels) {
+        if (s->num_levels == KLL_MAX_LEVELS) return;   // prakticno nedostizno (~2^24 * K unosa)
+        s->size[s->num_levels++] = 0;
+    }
+    float* lvl = s->items[h];
+    uint32_t n = s->size[h];
+    // Neparan element ostaje na svom nivou
+    uint32_t keep = n & 1u;
+    if (s->size[h + 1] + (n - keep) / 2 > KLL_LEVEL_BUF) compact_level(s, h + 1);
+    qsort(lvl, n, sizeof(float), compare_floats);
+    uint32_t offset = s->coin; s->coin ^= 1u;
+    float* up = s->items[h + 1];
+    for (uint32_t i = keep + offset; i < n; i += 2) {
+        if (s->size[h + 1] < KLL_LEVEL_BUF) up[s->size[h + 1]++] = lvl[i];
+    }
+    s->size[h] = keep;
+}
+
+static void compress(QuantileSketch* s) {
+    for (uint32_t h = 0; h < s->num_levels; h++) {
+        if (s->size[h] < level_capacity(s, h)) continue;
+        if (h + 1 == s->num_levels) {
+            if (s->num_levels == KLL_MAX_LEVELS) return;   // prakticno nedostizno (~2^24 * K unosa)
+            s->size[s->num_levels++] = 0;
+            // Novi nivo smanjuje kapacitete nizih, pa se provera krece ispocetka
+            h = (uint32_t)-1;
+            continue;
+        }
+        compact_level(s, h);
+    }
+}
+
+void quantile_sketch_add(QuantileSketch* s, float x) {
+    if (x < s->min) s->min = x;
+    if (x > s->max) s->max = x;
+    s->n++;
+    s->items[0][s->size[0]++] = x;
+    if (s->size[0] >= level_capacity(s, 0)) compress(s);
+}
+
+void quantile_sketch_merge(QuantileSketch* dst, const QuantileSketch* src) {
+    if (src->n == 0) return;
+    while (dst->num_levels < src->num_levels) dst->size[dst->num_levels++] = 0;
+    for (uint32_t h = 0; h < src->num_levels; h++) {
+        // Pun nivo se prvo kompaktuje navise, kao pri sabiranju, umesto da se visak odbaci
+        for (uint32_t copied = 0; copied < src->size[h]; ) {
+            if (dst->size[h] == KLL_LEVEL_BUF) { compact_level(dst, h); if (dst->size[h] == KLL_LEVEL_BUF) break; }
+            uint32_t room = KLL_LEVEL_BUF - dst->size[h], n = src->size[h] - copied;
+            if (n > room) n = room;
+            memcpy(&dst->items[h][dst->size[h]], &src->items[h][copied], n * sizeof(float));
+            dst->size[h] += n; copied += n;
+        }
+    }
+    dst->n += src->n;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+    // Jedan prolaz ne mora da bude dovoljan kad oba sketch-a imaju pune nivoe
+    for (int pass = 0; pass < 4; pass++) compress(dst);
+}
+
+typedef struct { float value; uint64_t weight; } Weighted;
+static int compare_weighted(const void* a, const void* b) { return compare_floats(&((const Weighted*)a)->value, &((const Weighted*)b)->value); }
+
+int quantile_sketch_query(const QuantileSketch* s, const float* qs, float* out, int nq) {
+    if (s->n == 0) return 0;
+    size_t total_items = 0;
+    for (uint32_t h = 0; h < s->num_levels; h++) total_items += s->size[h];
+    Weighted* all = scratch_alloc(total_items * sizeof(Weighted));   // na frejm niti iz frame arene
+    if (all == NULL) return 0;
+    size_t k = 0; uint64_t total_weight = 0;
+    for (uint32_t h = 0; h < s->num_levels; h++)
+        for (uint32_t i = 0; i < s->size[h]; i++) { all[k++] = (Weighted){ s->items[h][i], (uint64_t)1 << h }; total_weight += (uint64_t)1 << h; }
+    qsort(all, total_items, sizeof(Weighted), compare_weighted);
+    for (int q = 0; q < nq; q++) {
+        if (qs[q] <= 0.0f) { out[q] = s->min; continue; }
+        if (qs[q] >= 1.0f) { out[q] = s->max; continue; }
+        uint64_t target = (uint64_t)ceil(qs[q] * (double)total_weight), cum = 0;
+        out[q] = s->max;
+        for (size_t i = 0; i < total_items; i++) { cum += all[i].weight; if (cum >= target) { out[q] = all[i].value; break; } }
+    }
+    scratch_free(all);
+    return 1;
+}
+
+int quantile_sketch_save(const char* path, const QuantileSketch* s, int count) {
+    char tmp[512]; snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* f = fopen(tmp, "wb"); if (f == NULL) return 0;
+    uint32_t version = QS_VERSION, n = (uint32_t)count;
+    fwrite(QS_MAGIC, 1, 4, f); fwrite(&version, 4, 1, f); fwrite(&n, 4, 1, f);
+    for (int i = 0; i < count; i++) {
+        const QuantileSketch* q = &s[i];
+        fwrite(&q->n, sizeof(q->n), 1, f); fwrite(&q->num_levels, 4, 1, f); fwrite(&q->coin, 4, 1, f);
+        fwrite(&q->min, 4, 1, f); fwrite(&q->max, 4, 1, f);
+        fwrite(q->size, 4, q->num_levels, f);
+        for (uint32_t h = 0; h < q->num_levels; h++) fwrite(q->items[h], sizeof(float), q->size[h], f);
+    }
+    int ok = !ferror(f) && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    fclose(f);
+    if (ok && rename(tmp, path) == 0) return 1;
+    remove(tmp);
+    return 0;
+}
+
+int quantile_sketch_load(const char* path, QuantileSketch* s, int count) {
+    FILE* f = fopen(path, "rb"); if (f == NULL) return 0;
+    char magic[4]; uint32_t version, n;
+    int ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, QS_MAGIC, 4) == 0 &&
+             fread(&version, 4, 1, f) == 1 && version == QS_VERSION && fread(&n, 4, 1, f) == 1 && n == (uint32_t)count;
+    for (int i = 0; ok && i < count; i++) {
+        QuantileSketch* q = &s[i];
+        ok = fread(&q->n, sizeof(q->n), 1, f) == 1 && fread(&q->num_levels, 4, 1, f) == 1 && fread(&q->coin, 4, 1, f) == 1 &&
+             fread(&q->min, 4, 1, f) == 1 && fread(&q->max, 4, 1, f) == 1 &&
+             q->num_levels >= 1 && q->num_levels <= KLL_MAX_LEVELS && fread(q->size, 4, q->num_levels, f) == q->num_levels;
+        for (uint32_t h = 0; ok && h < q->num_levels; h++)
+            ok = q->size[h] <= KLL_LEVEL_BUF && fread(q->items[h], sizeof(float), q->size[h], f) == q->size[h];
+    }
+    fclose(f);
+    if (!ok) for (int i = 0; i < count; i++) quantile_sketch_init(&s[i]);
+    return ok;
+}
@@ -0,0 +1,34 @@
+#ifndef QUANTILE_H
+#define QUANTILE_H
+
+#include <stdint.h>
+
+// --- KLL sketch za kvantile ---
+// Niz kompaktora po nivoima: nivo h drzi uzorke tezine 2^h. Kad se nivo
+// napuni, sortira se i svaki drugi element (naizmenicno parni/neparni) ide
+// nivo vise. Memorija je ogranicena bez obzira na broj igara, a dva sketch-a
+// (npr. sa razlicitih masina ili batch radnika) se spajaju bez gubitka garancija.
+#define KLL_K 200
+#define KLL_MAX_LEVELS 24
+#define KLL_LEVEL_BUF (3 * KLL_K)   // nivo moze privremeno da primi vise od kapaciteta (spajanje)
+
+typedef struct {
+    uint64_t n;
+    uint32_t num_levels;
+    uint32_t coin;
+    float min, max;
+    uint32_t size[KLL_MAX_LEVELS];
+    float items[KLL_MAX_LEVELS][KLL_LEVEL_BUF];
+} QuantileSketch;
+
+void quantile_sketch_init(QuantileSketch* s);
+void quantile_sketch_add(QuantileSketch* s, float x);
+void quantile_sketch_merge(QuantileSketch* dst, const QuantileSketch* src);
+// Vise kvantila jednim sortiranjem; qs u [0,1]. Vraca 0 ako je sketch prazan.
+int quantile_sketch_query(const QuantileSketch* s, const float* qs, float* out, int nq);
+
+// Fajl sa nizom od `count` sketch-eva: "SBQS", verzija, pa sketch-evi redom
+int quantile_sketch_save(const char* path, const QuantileSketch* s, int count);
+int quantile_sketch_load(const char* path, QuantileSketch* s, int count);
+
+#endif
@@ -0,0 +1,47 @@
+#include "render.h"
+
+static inline float clampf(float v, float lo, float hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+PackedInstance pack_instance(Vec2 pos, Vec2 size, float rotation, Vec3 color) {
+    const float TWO_PI = 6.28318531f;
+    PackedInstance p;
+    // Van opsega je ionako van ekrana, pa je odsecanje bezbedno
+    p.x = (int16_t)lrintf(clampf(pos.x / INSTANCE_POS_RANGE, -1.0f, 1.0f) * 32767.0f);
+    p.y = (int16_t)lrintf(clampf(pos.y / INSTANCE_POS_RANGE, -1.0f, 1.0f) * 32767.0f);
+    float turns = rotation / TWO_PI;
+    turns -= floorf(turns);
+    p.angle = (uint16_t)((uint32_t)lrintf(turns * 65535.0f) & 0xFFFF);
+    // Vece od celog ekrana se ionako ne vidi celo, pa je odsecanje bezbedno
+    p.sx = (uint16_t)lrintf(sqrtf(clampf(size.x / INSTANCE_SIZE_RANGE, 0.0f, 1.0f)) * 65535.0f);
+    p.sy = (uint16_t)lrintf(sqrtf(clampf(size.y / INSTANCE_SIZE_RANGE, 0.0f, 1.0f)) * 65535.0f);
+    p.r = (uint8_t)lrintf(clampf(color.r, 0.0f, 1.0f) * 255.0f);
+    p.g = (uint8_t)lrintf(clampf(color.g, 0.0f, 1.0f) * 255.0f);
+    p.b = (uint8_t)lrintf(clampf(color.b, 0.0f, 1.0f) * 255.0f);
+    p.a = 255;
+    return p;
+}
+
+void batch_init(InstanceBatch* b, Arena* arena, int capacity) {
+    b->items = ARENA_NEW(arena, PackedInstance, capacity);
+    b->count = b->dropped = 0;
+    b->capacity = (b->items != NULL) ? capacity : 0;
+}
+
+void render_snapshot_build(RenderSnapshot* s, const GameState* g, Arena* arena) {
+    batch_init(&s->quads, arena, MAX_STARS + MAX_ASTEROIDS + MAX_BULLETS);
+    batch_init(&s->player, arena, 1);
+    s->game_over = g->game_over;
+
+    for (int i = 0; i < MAX_STARS; i++) {
+        float size, brightness;
+        if (g->stars.layer[i] == 0) { size = 0.005f; brightness = 0.3f; }
+        else if (g->stars.layer[i] == 1) { size = 0.008f; brightness = 0.6f; }
+        else { size = 0.012f; brightness = 1.0f; }
+        batch_push(&s->quads, (Vec2){g->stars.x[i], g->stars.y[i]}, (Vec2){size, size}, 0.0f, (Vec3){brightness, brightness, brightness});
+    }
+    if (!g->game_over) {
+        FOR_EACH_ASTEROID(g, i) batch_push(&s->quads, g->asteroids[i].position, g->asteroids[i].size, g->asteroids[i].rotation, g->asteroids[i].color);
+        FOR_EACH_BULLET(g, i) batch_push(&s->quads, g->bullets[i].position, g->bullets[i].size, g->bullets[i].rotation, g->bullets[i].color);
+    }
+    if (g->player_active) batch_push(&s->player, g->player.position, g->player.size, g->player.rotation, g->player.color);
+}
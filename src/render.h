@@ -0,0 +1,53 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "game.h"
+
+// --- Kompaktan format instance za GPU ---
+// 14 bajtova umesto ~32 (float pozicija, velicina, rotacija i RGB).
+// Sejder dekodira normalizovane atribute:
+//   pozicija: SNORM16 * INSTANCE_POS_RANGE
+//   ugao:     UNORM16 * 2*pi
+//   velicina: UNORM16, kvadratno kodirana (v*v * INSTANCE_SIZE_RANGE) da
+//             sitne zvezde i cifre ne izgube preciznost, a opseg pokriva
+//             i UI trake preko celog ekrana
+//   boja:     RGBA8
+typedef struct {
+    int16_t x, y;
+    uint16_t angle;
+    uint16_t sx, sy;
+    uint8_t r, g, b, a;
+} PackedInstance;
+
+_Static_assert(sizeof(PackedInstance) == 14, "PackedInstance mora imati 14 bajtova");
+
+#define INSTANCE_POS_RANGE 1.25f
+#define INSTANCE_SIZE_RANGE 2.0f   // ceo ekran
+
+PackedInstance pack_instance(Vec2 pos, Vec2 size, float rotation, Vec3 color);
+
+// Niz instanci u frame areni; kapacitet je poznat unapred pa nema realokacije.
+// Sta ne stane broji se u dropped (pozivalac prijavljuje).
+typedef struct { PackedInstance* items; int count, capacity, dropped; } InstanceBatch;
+
+void batch_init(InstanceBatch* b, Arena* arena, int capacity);
+static inline void batch_push(InstanceBatch* b, Vec2 pos, Vec2 size, float rotation, Vec3 color) {
+    if (b->count < b->capacity) b->items[b->count++] = pack_instance(pos, size, rotation, color);
+    else b->dropped++;
+}
+
+// --- Snimak stanja za crtanje ---
+// Sve sto je potrebno za crtanje sveta, vec spakovano; ne pokazuje nazad na
+// GameState pa se moze predati drugoj niti dok simulacija ide dalje.
+typedef struct {
+    InstanceBatch quads;    // zvezde, asteroidi, metci
+    InstanceBatch player;   // trougao igraca
+    int game_over;
+} RenderSnapshot;
+
+void render_snapshot_build(RenderSnapshot* s, const GameState* g, Arena* arena);
+
+#endif
@@ -0,0 +1,152 @@
+#include "replay.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+enum { FLAG_LEFT = 1, FLAG_RIGHT = 2, FLAG_SHOOT = 4, FLAG_MISSED_RULE = 8 };
+
+// --- Upis ---
+static void write_keyframe(ReplayWriter* w, const GameState* g) {
+    if (w->keyframe_count == w->keyframe_capacity) {
+        uint32_t cap = w->keyframe_capacity ? w->keyframe_capacity * 2 : 64;
+        ReplayKeyframe* grown = realloc(w->keyframes, cap * sizeof(ReplayKeyframe));
+        if (grown == NULL) { w->failed = 1; return; }
+        w->keyframes = grown; w->keyframe_capacity = cap;
+    }
+    long offset = ftell(w->file);
+    if (offset < 0 || fputc('K', w->file) == EOF || fwrite(g, sizeof(GameState), 1, w->file) != 1) { w->failed = 1; return; }
+    w->keyframes[w->keyframe_count++] = (ReplayKeyframe){ w->tick, 0, (uint64_t)offset };
+}
+
+int replay_writer_open(ReplayWriter* w, const char* path, const GameState* g, uint32_t interval) {
+    memset(w, 0, sizeof(*w));
+    w->interval = interval ? interval : REPLAY_KEYFRAME_INTERVAL;
+    w->file = fopen(path, "wb");
+    if (w->file == NULL) return 0;
+    setvbuf(w->file, NULL, _IOFBF, 1 << 16);
+    ReplayHeader h = { {0}, REPLAY_VERSION, (uint32_t)sizeof(GameState), w->interval, g->seed, 0 };
+    memcpy(h.magic, REPLAY_MAGIC, 4);
+    if (fwrite(&h, sizeof(h), 1, w->file) != 1) w->failed = 1;
+    return 1;
+}
+
+void replay_writer_tick(ReplayWriter* w, const GameState* g, const GameInput* in, double dt) {
+    if (w->file == NULL) return;
+    if (w->tick % w->interval == 0) write_keyframe(w, g);
+    uint8_t flags = (in->left ? FLAG_LEFT : 0) | (in->right ? FLAG_RIGHT : 0) | (in->shoot ? FLAG_SHOOT : 0) | (g->missed_asteroids_rule_enabled ? FLAG_MISSED_RULE : 0);
+    if (fputc('T', w->file) == EOF || fputc(flags, w->file) == EOF || fwrite(&dt, sizeof(dt), 1, w->file) != 1) w->failed = 1;
+    w->tick++;
+    w->total_time += dt;
+}
+
+int replay_writer_close(ReplayWriter* w) {
+    if (w->file == NULL) return 0;
+    long offset = ftell(w->file);
+    ReplayFooter f = { (uint64_t)(offset < 0 ? 0 : offset), w->keyframe_count, w->tick, w->total_time, {0}, 0 };
+    memcpy(f.magic, REPLAY_INDEX_MAGIC, 4);
+    if (offset < 0 || fwrite(w->keyframes, sizeof(ReplayKeyframe), w->keyframe_count, w->file) != w->keyframe_count || fwrite(&f, sizeof(f), 1, w->file) != 1) w->failed = 1;
+    if (fclose(w->file) != 0) w->failed = 1;
+    free(w->keyframes);
+    int ok = !w->failed;
+    memset(w, 0, sizeof(*w));
+    return ok;
+}
+
+// --- Citanje ---
+// Bez indeksa (igra prekinuta pre zatvaranja): jedan prolaz kroz sve zapise
+static int scan_records(Replay* r) {
+    uint32_t cap = 0;
+    if (fseek(r->file, 0, SEEK_END) != 0) return 0;
+    long size = ftell(r->file);
+    if (size < 0 || fseek(r->file, sizeof(ReplayHeader), SEEK_SET) != 0) return 0;
+    for (;;) {
+        long offset = ftell(r->file);
+        int tag = fgetc(r->file);
+        if (tag == 'K') {
+            // fseek moze i iza kraja fajla, pa se odsecen frejm prepoznaje po velicini
+            if (offset + 1 + (long)sizeof(GameState) > size || fseek(r->file, sizeof(GameState), SEEK_CUR) != 0) break;
+            if (r->keyframe_count == cap) {
+                cap = cap ? cap * 2 : 64;
+                ReplayKeyframe* grown = realloc(r->keyframes, cap * sizeof(ReplayKeyframe));
+                if (grown == NULL) return 0;
+                r->keyframes = grown;
+            }
+            r->keyframes[r->keyframe_count++] = (ReplayKeyframe){ r->tick_count, 0, (uint64_t)offset };
+        } else if (tag == 'T') {
+            uint8_t rec[1 + sizeof(double)];
+            double dt;
+            if (fread(rec, sizeof(rec), 1, r->file) != 1) break;
+            memcpy(&dt, rec + 1, sizeof(dt));
+            r->tick_count++;
+            r->total_time += dt;
+        } else break;
+    }
+    return r->keyframe_count > 0;
+}
+
+static int read_index(Replay* r) {
+    ReplayFooter f;
+    if (fseek(r->file, -(long)sizeof(f), SEEK_END) != 0 || fread(&f, sizeof(f), 1, r->file) != 1) return 0;
+    if (memcmp(f.magic, REPLAY_INDEX_MAGIC, 4) != 0 || f.keyframe_count == 0) return 0;
+    r->keyframes = malloc(f.keyframe_count * sizeof(ReplayKeyframe));
+    if (r->keyframes == NULL) return 0;
+    if (fseek(r->file, (long)f.index_offset, SEEK_SET) != 0 || fread(r->keyframes, sizeof(ReplayKeyframe), f.keyframe_count, r->file) != f.keyframe_count) {
+        free(r->keyframes); r->keyframes = NULL;
+        return 0;
+    }
+    r->keyframe_count = f.keyframe_count;
+    r->tick_count = f.tick_count;
+    r->total_time = f.total_time;
+    return 1;
+}
+
+int replay_open(Replay* r, const char* path) {
+    memset(r, 0, sizeof(*r));
+    r->file = fopen(path, "rb");
+    if (r->file == NULL) return 0;
+    ReplayHeader* h = &r->header;
+    if (fread(h, sizeof(*h), 1, r->file) != 1 || memcmp(h->magic, REPLAY_MAGIC, 4) != 0 || h->version != REPLAY_VERSION || h->state_size != sizeof(GameState)) {
+        replay_close(r);
+        return 0;
+    }
+    if (!read_index(r) && !scan_records(r)) { replay_close(r); return 0; }
+    return 1;
+}
+
+void replay_close(Replay* r) {
+    if (r->file != NULL) fclose(r->file);
+    free(r->keyframes);
+    memset(r, 0, sizeof(*r));
+}
+
+int replay_step(Replay* r, GameState* g) {
+    for (;;) {
+        if (r->tick >= r->tick_count) return 0;
+        int tag = fgetc(r->file);
+        if (tag == 'K') { if (fseek(r->file, sizeof(GameState), SEEK_CUR) != 0) return 0; continue; }
+        uint8_t rec[1 + sizeof(double)];
+        if (tag != 'T' || fread(rec, sizeof(rec), 1, r->file) != 1) return 0;
+        double dt;
+        memcpy(&dt, rec + 1, sizeof(dt));
+        // Isti redosled kao u igri: pravilo (taster M), pa ulaz, pa korak
+        GameInput in = { (rec[0] & FLAG_LEFT) != 0, (rec[0] & FLAG_RIGHT) != 0, (rec[0] & FLAG_SHOOT) != 0 };
+        g->missed_asteroids_rule_enabled = (rec[0] & FLAG_MISSED_RULE) != 0;
+        apply_input(g, &in, dt);
+        update_state(g, dt);
+        r->tick++;
+        return 1;
+    }
+}
+
+int replay_seek(Replay* r, GameState* g, uint32_t tick) {
+    if (r->keyframe_count == 0) return 0;
+    if (tick > r->tick_count) tick = r->tick_count;
+    // Poslednji kljucni frejm na ili pre trazenog koraka
+    uint32_t lo = 0, hi = r->keyframe_count - 1;
+    while (lo < hi) { uint32_t mid = (lo + hi + 1) / 2; if (r->keyframes[mid].tick <= tick) lo = mid; else hi = mid - 1; }
+    const ReplayKeyframe* k = &r->keyframes[lo];
+    if (fseek(r->file, (long)k->offset, SEEK_SET) != 0 || fgetc(r->file) != 'K' || fread(g, sizeof(GameState), 1, r->file) != 1) return 0;
+    r->tick = k->tick;
+    while (r->tick < tick) if (!replay_step(r, g)) return 0;
+    return 1;
+}
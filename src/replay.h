@@ -0,0 +1,61 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "game.h"
+
+// --- Snimci igre sa kljucnim frejmovima ---
+// Igra je deterministicka (game_rand, apply_input, update_state), pa snimak
+// cuva ulaz i dt svakog koraka; svakih `keyframe_interval` koraka jos i ceo
+// GameState. Na kraju fajla je indeks kljucnih frejmova (korak -> pomeraj),
+// pa se bilo koji korak dobija ucitavanjem najblizeg prethodnog kljucnog
+// frejma i premotavanjem najvise interval koraka, umesto od pocetka igre.
+// Fajl bez indeksa (prekinut upis) se cita skeniranjem zapisa.
+//
+// Format: zaglavlje, pa zapisi 'K' + GameState ili 'T' + flags + double dt,
+// pa indeks ReplayKeyframe[] i ReplayFooter. Snimak vazi samo za build sa
+// istim GameState-om (velicina se proverava u zaglavlju).
+#define REPLAY_MAGIC "RPL1"
+#define REPLAY_INDEX_MAGIC "RIDX"
+#define REPLAY_VERSION 1
+#define REPLAY_KEYFRAME_INTERVAL 600
+
+typedef struct { char magic[4]; uint32_t version, state_size, keyframe_interval, seed, reserved; } ReplayHeader;
+typedef struct { uint32_t tick, reserved; uint64_t offset; } ReplayKeyframe;
+typedef struct { uint64_t index_offset; uint32_t keyframe_count, tick_count; double total_time; char magic[4]; uint32_t reserved; } ReplayFooter;
+
+typedef struct {
+    FILE* file;
+    uint32_t tick, interval;
+    ReplayKeyframe* keyframes;
+    uint32_t keyframe_count, keyframe_capacity;
+    double total_time;
+    int failed;
+} ReplayWriter;
+
+typedef struct {
+    FILE* file;
+    ReplayHeader header;
+    ReplayKeyframe* keyframes;
+    uint32_t keyframe_count, tick_count;
+    double total_time;
+    uint32_t tick;   // korak do kog je stanje poslednjeg seek/step stiglo
+} Replay;
+
+// Pocinje snimak od stanja g (pre prvog koraka); interval 0 = REPLAY_KEYFRAME_INTERVAL
+int replay_writer_open(ReplayWriter* w, const char* path, const GameState* g, uint32_t interval);
+// Poziva se pre apply_input/update_state koraka, sa stanjem na pocetku koraka
+void replay_writer_tick(ReplayWriter* w, const GameState* g, const GameInput* in, double dt);
+// Upisuje indeks i zatvara; vraca 0 ako je bilo gresaka pri upisu
+int replay_writer_close(ReplayWriter* w);
+
+int replay_open(Replay* r, const char* path);
+void replay_close(Replay* r);
+// Stanje na pocetku koraka `tick` (0 = pocetak igre); vraca 0 ako fajl ne moze da se procita
+int replay_seek(Replay* r, GameState* g, uint32_t tick);
+// Jedan korak unapred od tekuceg stanja; vraca 0 na kraju snimka
+int replay_step(Replay* r, GameState* g);
+
+#endif
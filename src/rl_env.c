@@ -0,0 +1,235 @@
+#define _POSIX_C_SOURCE 200809L
+#include "rl_env.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "game.h"
+#include "pixel_obs.h"
+
+#define RL_DT (1.0 / 60.0)
+
+_Static_assert(RL_PIXELS_RGB == PIXEL_OBS_RGB && RL_PIXELS_STARS == PIXEL_OBS_STARS, "RL_PIXELS_* moraju odgovarati PIXEL_OBS_*");
+
+enum { JOB_RESET, JOB_STEP, JOB_RENDER };
+
+typedef struct { struct RlEnv* env; int index; } RlWorker;
+
+struct RlEnv {
+    int num_envs, num_threads, frame_skip;
+    GameState* games;
+    // Stanje okruzenja, niz po okruzenju
+    uint32_t* seeds;
+    int32_t* prev_destroyed;
+    int32_t* prev_missed;
+    // Tekuci posao; niti ga citaju posle budjenja pod mutex-om
+    int job;
+    const int32_t* actions;
+    float* obs;
+    float* reward;
+    uint8_t* done;
+    uint8_t* pixels;
+    int pixel_w, pixel_h, pixel_flags;
+    // Niti 1..num_threads-1; blok 0 radi pozivalac
+    pthread_t threads[RL_MAX_THREADS];
+    RlWorker workers[RL_MAX_THREADS];
+    pthread_mutex_t mutex;
+    pthread_cond_t start_cond, done_cond;
+    uint64_t generation;
+    int pending, stopping, started;
+};
+
+static void start_episode(RlEnv* e, int i) {
+    GameState* g = &e->games[i];
+    initialize_game(g, e->seeds[i]);
+    g->missed_asteroids_rule_enabled = 1;
+    e->prev_destroyed[i] = 0;
+    e->prev_missed[i] = 0;
+}
+
+// K najblizih (po kvadratu rastojanja) ubacivanjem u sortiran niz
+#define NEAREST_INSERT(idx, d2, n, k, i, d) do { \
+        int p_ = (n) < (k) ? (n)++ : (k); \
+        if (p_ == (k) && (d) >= (d2)[(k) - 1]) break; \
+        if (p_ == (k)) p_ = (k) - 1; \
+        while (p_ > 0 && (d2)[p_ - 1] > (d)) { (d2)[p_] = (d2)[p_ - 1]; (idx)[p_] = (idx)[p_ - 1]; p_--; } \
+        (d2)[p_] = (d); (idx)[p_] = (i); \
+    } while (0)
+
+static void write_obs(const GameState* g, float* o) {
+    float px = g->player.position.x, py = g->player.position.y;
+    o[0] = px;
+    o[1] = g->shoot_cooldown <= 0.0 ? 1.0f : 1.0f - (float)(g->shoot_cooldown / SHOOT_COOLDOWN);
+    o[2] = (float)g->asteroids_missed / MISSED_ASTEROID_LIMIT;
+    o[3] = g->score / 1000.0f;
+    o += 4;
+
+    int idx[RL_OBS_ASTEROIDS > RL_OBS_BULLETS ? RL_OBS_ASTEROIDS : RL_OBS_BULLETS], n = 0;
+    float d2[RL_OBS_ASTEROIDS > RL_OBS_BULLETS ? RL_OBS_ASTEROIDS : RL_OBS_BULLETS];
+    FOR_EACH_ASTEROID(g, i) {
+        float dx = g->asteroids[i].position.x - px, dy = g->asteroids[i].position.y - py, d = dx * dx + dy * dy;
+        NEAREST_INSERT(idx, d2, n, RL_OBS_ASTEROIDS, i, d);
+    }
+    memset(o, 0, sizeof(float) * (RL_OBS_ASTEROIDS * 4 + RL_OBS_BULLETS * 2));
+    for (int k = 0; k < n; k++) {
+        const GameObject* a = &g->asteroids[idx[k]];
+        o[k * 4 + 0] = a->position.x - px;
+        o[k * 4 + 1] = a->position.y - py;
+        o[k * 4 + 2] = a->velocity.y;
+        o[k * 4 + 3] = a->size.x;
+    }
+    o += RL_OBS_ASTEROIDS * 4;
+
+    n = 0;
+    FOR_EACH_BULLET(g, i) {
+        float dx = g->bullets[i].position.x - px, dy = g->bullets[i].position.y - py, d = dx * dx + dy * dy;
+        NEAREST_INSERT(idx, d2, n, RL_OBS_BULLETS, i, d);
+    }
+    for (int k = 0; k < n; k++) {
+        o[k * 2 + 0] = g->bullets[idx[k]].position.x - px;
+        o[k * 2 + 1] = g->bullets[idx[k]].position.y - py;
+    }
+}
+
+static void step_env(RlEnv* e, int i) {
+    GameState* g = &e->games[i];
+    int a = e->actions[i];
+    GameInput in = {
+        .left = a == RL_LEFT || a == RL_LEFT_SHOOT,
+        .right = a == RL_RIGHT || a == RL_RIGHT_SHOOT,
+        .shoot = a == RL_SHOOT || a == RL_LEFT_SHOOT || a == RL_RIGHT_SHOOT,
+    };
+    int over = 0;
+    for (int k = 0; k < e->frame_skip && !over; k++) {
+        apply_input(g, &in, RL_DT);
+        over = update_state(g, RL_DT);
+    }
+    float r = (float)(g->asteroids_destroyed - e->prev_destroyed[i]) - 0.1f * (float)(g->asteroids_missed - e->prev_missed[i]) - (over ? 1.0f : 0.0f);
+    e->prev_destroyed[i] = g->asteroids_destroyed;
+    e->prev_missed[i] = g->asteroids_missed;
+    if (over) { e->seeds[i] += (uint32_t)e->num_envs; start_episode(e, i); }
+    if (e->reward != NULL) e->reward[i] = r;
+    if (e->done != NULL) e->done[i] = (uint8_t)over;
+}
+
+static void run_block(RlEnv* e, int block) {
+    int begin = (int)((long long)e->num_envs * block / e->num_threads);
+    int end = (int)((long long)e->num_envs * (block + 1) / e->num_threads);
+    if (e->job == JOB_RENDER) {
+        size_t frame = (size_t)pixel_obs_size(e->pixel_w, e->pixel_h, e->pixel_flags);
+        for (int i = begin; i < end; i++) pixel_obs_render(&e->games[i], e->pixels + frame * i, e->pixel_w, e->pixel_h, e->pixel_flags);
+        return;
+    }
+    for (int i = begin; i < end; i++) {
+        if (e->job == JOB_STEP) step_env(e, i);
+        else start_episode(e, i);
+        if (e->obs != NULL) write_obs(&e->games[i], e->obs + (size_t)i * RL_OBS_SIZE);
+    }
+}
+
+static void* worker_main(void* arg) {
+    RlWorker* w = arg;
+    RlEnv* e = w->env;
+    uint64_t seen = 0;
+    pthread_mutex_lock(&e->mutex);
+    for (;;) {
+        while (e->generation == seen && !e->stopping) pthread_cond_wait(&e->start_cond, &e->mutex);
+        if (e->stopping) break;
+        seen = e->generation;
+        pthread_mutex_unlock(&e->mutex);
+        run_block(e, w->index);
+        pthread_mutex_lock(&e->mutex);
+        if (--e->pending == 0) pthread_cond_signal(&e->done_cond);
+    }
+    pthread_mutex_unlock(&e->mutex);
+    return NULL;
+}
+
+// Svi blokovi jednog posla; vraca se kad su sve niti gotove
+static void run_job(RlEnv* e) {
+    if (e->num_threads > 1) {
+        pthread_mutex_lock(&e->mutex);
+        e->pending = e->num_threads - 1;
+        e->generation++;
+        pthread_cond_broadcast(&e->start_cond);
+        pthread_mutex_unlock(&e->mutex);
+    }
+    run_block(e, 0);
+    if (e->num_threads > 1) {
+        pthread_mutex_lock(&e->mutex);
+        while (e->pending > 0) pthread_cond_wait(&e->done_cond, &e->mutex);
+        pthread_mutex_unlock(&e->mutex);
+    }
+}
+
+RlEnv* rl_env_create(int num_envs, int num_threads, int frame_skip) {
+    if (num_envs <= 0) return NULL;
+    if (num_threads <= 0) { long cores = sysconf(_SC_NPROCESSORS_ONLN); num_threads = cores > 0 ? (int)cores : 1; }
+    if (num_threads > RL_MAX_THREADS) num_threads = RL_MAX_THREADS;
+    if (num_threads > num_envs) num_threads = num_envs;
+    RlEnv* e = calloc(1, sizeof(RlEnv));
+    if (e == NULL) return NULL;
+    e->num_envs = num_envs;
+    e->num_threads = num_threads;
+    e->frame_skip = frame_skip < 1 ? 1 : frame_skip;
+    // Niz igara pocinje na liniji kesa (aligned_alloc trazi velicinu deljivu poravnanjem)
+    size_t games_size = (sizeof(GameState) * (size_t)num_envs + 63) & ~(size_t)63;
+    e->games = aligned_alloc(64, games_size);
+    e->seeds = calloc((size_t)num_envs, sizeof(uint32_t));
+    e->prev_destroyed = calloc((size_t)num_envs, sizeof(int32_t));
+    e->prev_missed = calloc((size_t)num_envs, sizeof(int32_t));
+    if (e->games == NULL || e->seeds == NULL || e->prev_destroyed == NULL || e->prev_missed == NULL) { rl_env_destroy(e); return NULL; }
+    memset(e->games, 0, games_size);
+    pthread_mutex_init(&e->mutex, NULL);
+    pthread_cond_init(&e->start_cond, NULL);
+    pthread_cond_init(&e->done_cond, NULL);
+    for (int t = 1; t < num_threads; t++) {
+        e->workers[t] = (RlWorker){ e, t };
+        if (pthread_create(&e->threads[t], NULL, worker_main, &e->workers[t]) != 0) { e->num_threads = t; break; }
+        e->started = t;
+    }
+    for (int i = 0; i < num_envs; i++) { e->seeds[i] = (uint32_t)i + 1; start_episode(e, i); }
+    return e;
+}
+
+void rl_env_destroy(RlEnv* e) {
+    if (e == NULL) return;
+    if (e->started > 0) {
+        pthread_mutex_lock(&e->mutex);
+        e->stopping = 1;
+        pthread_cond_broadcast(&e->start_cond);
+        pthread_mutex_unlock(&e->mutex);
+        for (int t = 1; t <= e->started; t++) pthread_join(e->threads[t], NULL);
+        pthread_mutex_destroy(&e->mutex);
+        pthread_cond_destroy(&e->start_cond);
+        pthread_cond_destroy(&e->done_cond);
+    }
+    free(e->games); free(e->seeds); free(e->prev_destroyed); free(e->prev_missed);
+    free(e);
+}
+
+int rl_env_num_envs(const RlEnv* e) { return e->num_envs; }
+int rl_env_obs_size(void) { return RL_OBS_SIZE; }
+uint32_t rl_env_seed(const RlEnv* e, int i) { return (i >= 0 && i < e->num_envs) ? e->seeds[i] : 0; }
+
+void rl_env_reset(RlEnv* e, uint32_t seed, float* obs) {
+    for (int i = 0; i < e->num_envs; i++) e->seeds[i] = seed + (uint32_t)i;
+    e->job = JOB_RESET;
+    e->actions = NULL; e->obs = obs; e->reward = NULL; e->done = NULL;
+    run_job(e);
+}
+
+void rl_env_step(RlEnv* e, const int32_t* actions, float* obs, float* reward, uint8_t* done) {
+    e->job = JOB_STEP;
+    e->actions = actions; e->obs = obs; e->reward = reward; e->done = done;
+    run_job(e);
+}
+
+void rl_env_render(RlEnv* e, uint8_t* pixels, int w, int h, int flags) {
+    if (w <= 0 || h <= 0) return;
+    e->job = JOB_RENDER;
+    e->pixels = pixels; e->pixel_w = w; e->pixel_h = h; e->pixel_flags = flags;
+    run_job(e);
+}
@@ -0,0 +1,45 @@
+#ifndef RL_ENV_H
+#define RL_ENV_H
+
+#include <stdint.h>
+
+// --- Vektorizovano okruzenje za ucenje (C API, deljena biblioteka) ---
+// N igara se koraca u korak (lockstep) fiksnim korakom od 1/60 s, podeljeno na
+// niti u blokove susednih okruzenja. Svaka igra je obican GameState sa istim
+// pravilima kao prava igra (update_state, apply_input), a stanje na nivou
+// okruzenja (nagrade, brojaci, seme) stoji u nizovima po okruzenju.
+//
+// Opservacija je RL_OBS_SIZE float-ova po okruzenju, redom:
+//   igrac x, spremnost za pucanje (0..1), promaseni / limit, rezultat / 1000,
+//   RL_OBS_ASTEROIDS najblizih asteroida: dx, dy, brzina y, velicina (prazno = 0),
+//   RL_OBS_BULLETS najblizih metaka: dx, dy (prazno = 0).
+// Nagrada: +1 po oborenom asteroidu, -0.1 po promasenom, -1 za kraj igre.
+// Okruzenje koje zavrsi (done) odmah krece novu igru; vracena opservacija je
+// vec iz nove igre, kao u uobicajenim vektorskim okruzenjima.
+#define RL_OBS_ASTEROIDS 8
+#define RL_OBS_BULLETS 4
+#define RL_OBS_SIZE (4 + RL_OBS_ASTEROIDS * 4 + RL_OBS_BULLETS * 2)
+#define RL_MAX_THREADS 64
+
+enum { RL_NOOP, RL_LEFT, RL_RIGHT, RL_SHOOT, RL_LEFT_SHOOT, RL_RIGHT_SHOOT, RL_ACTION_COUNT };
+
+typedef struct RlEnv RlEnv;
+
+// num_threads <= 0: broj jezgara; frame_skip: koliko koraka igre po akciji (>= 1)
+RlEnv* rl_env_create(int num_envs, int num_threads, int frame_skip);
+void rl_env_destroy(RlEnv* env);
+int rl_env_num_envs(const RlEnv* env);
+int rl_env_obs_size(void);
+// Okruzenje i dobija seme seed + i; obs: num_envs * RL_OBS_SIZE
+void rl_env_reset(RlEnv* env, uint32_t seed, float* obs);
+// actions[num_envs] iz RL_ACTION_COUNT; bilo koji od izlaza moze biti NULL
+void rl_env_step(RlEnv* env, const int32_t* actions, float* obs, float* reward, uint8_t* done);
+// Seme tekuce igre okruzenja i (za ponavljanje epizode u igri sa --seed)
+uint32_t rl_env_seed(const RlEnv* env, int i);
+// Tekuce stanje svih okruzenja u piksele (src/pixel_obs.h), na istim nitima;
+// pixels: num_envs * w * h * (1 ili 3 za RL_PIXELS_RGB) bajtova
+#define RL_PIXELS_RGB 1
+#define RL_PIXELS_STARS 2
+void rl_env_render(RlEnv* env, uint8_t* pixels, int w, int h, int flags);
+
+#endif
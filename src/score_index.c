@@ -0,0 +1,111 @@
+#include "score_index.h"
+
+#include <stdlib.h>
+
+static uint32_t node_priority(uint32_t i) {
+    // Deterministican hes indeksa umesto rand(), da ne dira sekvencu igre
+    uint32_t x = i * 2654435761u;
+    x ^= x >> 16; x *= 0x7feb352du; x ^= x >> 15;
+    return x;
+}
+
+static inline uint64_t subtree(const ScoreIndex* ix, uint32_t n) { return n ? ix->nodes[n].total : 0; }
+static inline void pull(ScoreIndex* ix, uint32_t n) {
+    ScoreNode* node = &ix->nodes[n];
+    node->total = node->count + subtree(ix, node->left) + subtree(ix, node->right);
+}
+
+void score_index_init(ScoreIndex* ix, uint32_t reserve_nodes) {
+    ix->node_cap = reserve_nodes < 16 ? 16 : reserve_nodes;
+    ix->nodes = malloc(ix->node_cap * sizeof(ScoreNode));
+    ix->node_count = 1;
+    ix->root = 0;
+    if (ix->nodes == NULL) ix->node_cap = 0;
+}
+
+void score_index_free(ScoreIndex* ix) { free(ix->nodes); *ix = (ScoreIndex){0}; }
+
+static uint32_t new_node(ScoreIndex* ix, int32_t score, uint32_t count) {
+    if (ix->node_count == ix->node_cap) {
+        uint32_t cap = ix->node_cap ? ix->node_cap * 2 : 16;
+        ScoreNode* grown = realloc(ix->nodes, cap * sizeof(ScoreNode));
+        if (grown == NULL) return 0;
+        ix->nodes = grown; ix->node_cap = cap;
+        if (ix->node_count == 0) ix->node_count = 1;
+    }
+    uint32_t n = ix->node_count++;
+    ix->nodes[n] = (ScoreNode){ score, count, count, node_priority(n), 0, 0 };
+    return n;
+}
+
+static uint32_t rotate_right(ScoreIndex* ix, uint32_t n) {
+    uint32_t l = ix->nodes[n].left;
+    ix->nodes[n].left = ix->nodes[l].right; ix->nodes[l].right = n;
+    pull(ix, n); pull(ix, l);
+    return l;
+}
+static uint32_t rotate_left(ScoreIndex* ix, uint32_t n) {
+    uint32_t r = ix->nodes[n].right;
+    ix->nodes[n].right = ix->nodes[r].left; ix->nodes[r].left = n;
+    pull(ix, n); pull(ix, r);
+    return r;
+}
+
+// Levo podstablo = veci rezultati, da bi in-order obilazak isao od najboljeg
+static uint32_t insert(ScoreIndex* ix, uint32_t n, int32_t score, uint32_t count) {
+    if (n == 0) return new_node(ix, score, count);
+    if (score == ix->nodes[n].score) { ix->nodes[n].count += count; ix->nodes[n].total += count; return n; }
+    if (score > ix->nodes[n].score) {
+        uint32_t child = insert(ix, ix->nodes[n].left, score, count);
+        ix->nodes[n].left = child;
+        pull(ix, n);
+        if (child && ix->nodes[child].priority > ix->nodes[n].priority) n = rotate_right(ix, n);
+    } else {
+        uint32_t child = insert(ix, ix->nodes[n].right, score, count);
+        ix->nodes[n].right = child;
+        pull(ix, n);
+        if (child && ix->nodes[child].priority > ix->nodes[n].priority) n = rotate_left(ix, n);
+    }
+    return n;
+}
+
+void score_index_add(ScoreIndex* ix, int32_t score, uint32_t count) {
+    if (count == 0) return;
+    ix->root = insert(ix, ix->root, score, count);
+}
+
+uint64_t score_index_rank(const ScoreIndex* ix, int32_t score) {
+    uint64_t better = 0;
+    for (uint32_t n = ix->root; n; ) {
+        const ScoreNode* node = &ix->nodes[n];
+        if (score < node->score) { better += subtree(ix, node->left) + node->count; n = node->right; }
+        else if (score > node->score) n = node->left;
+        else { better += subtree(ix, node->left); break; }
+    }
+    return better + 1;
+}
+
+int score_index_select(const ScoreIndex* ix, uint64_t rank, int32_t* score) {
+    if (rank == 0 || rank > score_index_total(ix)) return 0;
+    for (uint32_t n = ix->root; n; ) {
+        const ScoreNode* node = &ix->nodes[n];
+        uint64_t left = subtree(ix, node->left);
+        if (rank <= left) n = node->left;
+        else if (rank <= left + node->count) { *score = node->score; return 1; }
+        else { rank -= left + node->count; n = node->right; }
+    }
+    return 0;
+}
+
+int score_index_range(const ScoreIndex* ix, uint64_t first_rank, int32_t* out, int n) {
+    int written = 0;
+    // Isti rezultat pokriva vise uzastopnih plasmana, pa se select radi po cvoru, ne po plasmanu
+    uint64_t rank = first_rank ? first_rank : 1, total = score_index_total(ix);
+    while (written < n && rank <= total) {
+        int32_t s; score_index_select(ix, rank, &s);
+        // Prvi plasman posle svih igara sa rezultatom s; INT32_MIN je najgori moguci, s - 1 bi se prelio
+        uint64_t next = s == INT32_MIN ? total + 1 : score_index_rank(ix, s - 1);
+        for (; rank < next && written < n; rank++) out[written++] = s;
+    }
+    return written;
+}
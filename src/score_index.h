@@ -0,0 +1,37 @@
+#ifndef SCORE_INDEX_H
+#define SCORE_INDEX_H
+
+#include <stdint.h>
+
+// --- Indeks svih rezultata (order-statistic stablo) ---
+// Treap po rezultatu; svaki cvor nosi broj igara sa tim rezultatom i ukupan
+// broj igara u svom podstablu. Rezultata ima malo razlicitih (umnosci 10),
+// pa milioni igara staju u par hiljada cvorova, a sve operacije su O(log n).
+// Rangovi su 1-based, 1 = najbolji rezultat.
+typedef struct {
+    int32_t score;
+    uint32_t count;       // igara sa ovim rezultatom
+    uint64_t total;       // igara u podstablu
+    uint32_t priority;
+    uint32_t left, right; // 0 = nema (cvor 0 je rezervisan)
+} ScoreNode;
+
+typedef struct {
+    ScoreNode* nodes;
+    uint32_t node_count, node_cap;
+    uint32_t root;
+} ScoreIndex;
+
+void score_index_init(ScoreIndex* ix, uint32_t reserve_nodes);
+void score_index_free(ScoreIndex* ix);
+void score_index_add(ScoreIndex* ix, int32_t score, uint32_t count);
+static inline uint64_t score_index_total(const ScoreIndex* ix) { return ix->root ? ix->nodes[ix->root].total : 0; }
+// Plasman igre sa datim rezultatom: 1 + broj strogo boljih igara
+uint64_t score_index_rank(const ScoreIndex* ix, int32_t score);
+// Rezultat na datom plasmanu; 0 ako plasman ne postoji
+int score_index_select(const ScoreIndex* ix, uint64_t rank, int32_t* score);
+// Rezultati na plasmanima [first_rank, first_rank + n); vraca koliko ih je upisano
+int score_index_range(const ScoreIndex* ix, uint64_t first_rank, int32_t* out, int n);
+static inline int score_index_top(const ScoreIndex* ix, int32_t* out, int k) { return score_index_range(ix, 1, out, k); }
+
+#endif
@@ -0,0 +1,99 @@
+#define _POSIX_C_SOURCE 200809L
+#include "telemetry.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TELEMETRY_SLOTS 64                   // stepen dvojke
+#define TELEMETRY_RECORD_MAX 512
+#define TELEMETRY_INTERVAL_NS 250000000L     // nit se budi na 250 ms
+
+// SPSC red gotovih JSON redova: frejm nit pise head, nit za upis tail
+static char slots[TELEMETRY_SLOTS][TELEMETRY_RECORD_MAX];
+static atomic_uint slot_head, slot_tail;
+static atomic_int writer_stop;
+static pthread_t writer_thread;
+static int writer_running = 0;
+static unsigned long dropped = 0;
+static FILE* out = NULL;
+
+void frame_stats_reset(FrameTimeStats* f) { memset(f, 0, sizeof(*f)); }
+
+double frame_stats_quantile(const FrameTimeStats* f, double q) {
+    if (f->count == 0) return 0.0;
+    uint64_t target = (uint64_t)(q * (double)(f->count - 1)) + 1, seen = 0;
+    for (int i = 0; i < FRAME_HIST_BINS; i++) {
+        seen += f->bins[i];
+        if (seen >= target) return i == FRAME_HIST_BINS - 1 ? f->max_ms : (i + 1) * FRAME_HIST_BIN_MS;
+    }
+    return f->max_ms;
+}
+
+// telemetry.jsonl.(KEEP-1) -> .KEEP, ..., telemetry.jsonl -> .1
+static void rotate() {
+    char from[64], to[64];
+    if (out != NULL) { fclose(out); out = NULL; }
+    for (int i = TELEMETRY_KEEP - 1; i >= 1; i--) {
+        snprintf(from, sizeof(from), "%s.%d", TELEMETRY_FILE, i);
+        snprintf(to, sizeof(to), "%s.%d", TELEMETRY_FILE, i + 1);
+        rename(from, to);
+    }
+    snprintf(to, sizeof(to), "%s.1", TELEMETRY_FILE);
+    rename(TELEMETRY_FILE, to);
+}
+
+static void writer_drain() {
+    unsigned tail = atomic_load_explicit(&slot_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&slot_head, memory_order_acquire);
+    if (tail == head) return;
+    if (out == NULL) { out = fopen(TELEMETRY_FILE, "a"); if (out == NULL) return; setvbuf(out, NULL, _IOFBF, 1 << 16); }
+    for (; tail != head; tail++) fputs(slots[tail & (TELEMETRY_SLOTS - 1)], out);
+    atomic_store_explicit(&slot_tail, tail, memory_order_release);
+    fflush(out);
+    if (ftell(out) >= (long)TELEMETRY_MAX_BYTES) rotate();
+}
+
+static void* writer_main(void* arg) {
+    (void)arg;
+    struct timespec interval = { 0, TELEMETRY_INTERVAL_NS };
+    while (!atomic_load_explicit(&writer_stop, memory_order_acquire)) {
+        nanosleep(&interval, NULL);
+        writer_drain();
+    }
+    writer_drain();
+    return NULL;
+}
+
+void telemetry_start() {
+    if (writer_running) return;
+    atomic_store(&writer_stop, 0);
+    if (pthread_create(&writer_thread, NULL, writer_main, NULL) == 0) writer_running = 1;
+}
+
+void telemetry_record_run(const GameState* g, const FrameTimeStats* f, int game_over) {
+    unsigned head = atomic_load_explicit(&slot_head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&slot_tail, memory_order_acquire) == TELEMETRY_SLOTS) { dropped++; return; }
+    snprintf(slots[head & (TELEMETRY_SLOTS - 1)], TELEMETRY_RECORD_MAX,
+             "{\"v\":%d,\"t\":%lld,\"seed\":%u,\"duration_s\":%.3f,\"score\":%d,\"asteroids_missed\":%d,\"shots\":%d,\"hits\":%d,"
+             "\"missed_rule\":%s,\"game_over\":%s,\"frames\":%llu,\"frame_ms\":{\"mean\":%.3f,\"p50\":%.1f,\"p95\":%.1f,\"p99\":%.1f,\"max\":%.3f}}\n",
+             TELEMETRY_SCHEMA, (long long)time(NULL), (unsigned)g->seed, g->run_time, g->score, g->asteroids_missed, g->shots_fired, g->asteroids_destroyed,
+             g->missed_asteroids_rule_enabled ? "true" : "false", game_over ? "true" : "false", (unsigned long long)f->count,
+             f->count ? f->sum_ms / (double)f->count : 0.0, frame_stats_quantile(f, 0.5), frame_stats_quantile(f, 0.95), frame_stats_quantile(f, 0.99), f->max_ms);
+    atomic_store_explicit(&slot_head, head + 1, memory_order_release);
+    // Bez niti (nije pokrenuta ili nije uspela) upis ide odmah
+    if (!writer_running) writer_drain();
+}
+
+void telemetry_stop() {
+    if (writer_running) {
+        atomic_store_explicit(&writer_stop, 1, memory_order_release);
+        pthread_join(writer_thread, NULL);
+        writer_running = 0;
+    }
+    writer_drain();
+    if (out != NULL) { fclose(out); out = NULL; }
+    if (dropped > 0) { fprintf(stderr, "Telemetrija: %lu zapisa odbaceno (pun red)\n", dropped); dropped = 0; }
+}
@@ -0,0 +1,46 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+#include "game.h"
+
+// --- Telemetrija po igri ---
+// Svaka zavrsena (ili prekinuta) igra daje jedan JSON red u TELEMETRY_FILE:
+// seme, trajanje, rezultat, promasaji, pucnji, pogoci, stanje pravila
+// promasenih asteroida i statistika vremena frejma. Frejm nit samo formatira
+// red u slobodan slot ogranicenog reda; upis, flush i rotaciju fajla radi
+// pozadinska nit. Ako je red pun, zapis se odbacuje i broji (frejm nikad ne ceka).
+#define TELEMETRY_FILE "telemetry.jsonl"
+#define TELEMETRY_MAX_BYTES (4u << 20)   // rotacija: telemetry.jsonl -> .1 -> ... -> .TELEMETRY_KEEP
+#define TELEMETRY_KEEP 4
+#define TELEMETRY_SCHEMA 1
+
+// Histogram vremena frejma jedne igre: korpe od 0.1 ms do 100 ms, duzi frejmovi idu u poslednju
+#define FRAME_HIST_BINS 1000
+#define FRAME_HIST_BIN_MS 0.1
+typedef struct {
+    uint32_t bins[FRAME_HIST_BINS];
+    uint64_t count;
+    double sum_ms, max_ms;
+} FrameTimeStats;
+
+void frame_stats_reset(FrameTimeStats* f);
+static inline void frame_stats_add(FrameTimeStats* f, double seconds) {
+    double ms = seconds * 1000.0;
+    // Opseg se proverava pre konverzije: ogroman (ili NaN) dt ne sme u (int)
+    double x = ms / FRAME_HIST_BIN_MS;
+    f->bins[!(x > 0.0) ? 0 : x < FRAME_HIST_BINS ? (int)x : FRAME_HIST_BINS - 1]++;
+    f->count++; f->sum_ms += ms;
+    if (ms > f->max_ms) f->max_ms = ms;
+}
+// Gornja granica korpe u kojoj je kvantil q (ms); 0 ako nema frejmova
+double frame_stats_quantile(const FrameTimeStats* f, double q);
+
+void telemetry_start();
+// game_over = 0 za igru prekinutu zatvaranjem prozora
+void telemetry_record_run(const GameState* g, const FrameTimeStats* f, int game_over);
+// Upisuje sve sto je ostalo u redu i gasi nit (bezbedno vise puta)
+void telemetry_stop();
+
+#endif
@@ -0,0 +1,100 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trace.h"
+
+#ifdef PROFILE
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TRACE_MAX_THREADS 16
+#define TRACE_RING_EVENTS (1u << 16)   // stepen dvojke; ~1.5 MB po niti
+
+typedef struct { const char* name; uint64_t start_ns, dur_ns; } TraceEvent;
+typedef struct {
+    TraceEvent* events;
+    atomic_ullong head;     // ukupno upisanih; pise samo vlasnik
+    const char* name;
+    int tid;
+} TraceRing;
+
+static TraceRing rings[TRACE_MAX_THREADS];
+static atomic_int ring_count;
+static _Thread_local TraceRing* my_ring = NULL;
+static _Thread_local int my_ring_failed = 0;
+
+static uint64_t now_ns() { struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return (uint64_t)t.tv_sec * 1000000000ull + (uint64_t)t.tv_nsec; }
+
+// Prvi dogadjaj niti zauzima slot; bez slobodnog slota nit se ne meri
+static TraceRing* thread_ring() {
+    if (my_ring != NULL || my_ring_failed) return my_ring;
+    TraceEvent* events = calloc(TRACE_RING_EVENTS, sizeof(TraceEvent));
+    int i = events != NULL ? atomic_fetch_add(&ring_count, 1) : TRACE_MAX_THREADS;
+    if (i >= TRACE_MAX_THREADS) { free(events); my_ring_failed = 1; return NULL; }
+    rings[i].events = events;
+    rings[i].tid = i + 1;
+    my_ring = &rings[i];
+    return my_ring;
+}
+
+void trace_thread_name(const char* name) { TraceRing* r = thread_ring(); if (r != NULL) r->name = name; }
+
+TraceZone trace_zone_begin(const char* name) { return (TraceZone){ name, now_ns() }; }
+
+void trace_zone_end(TraceZone* z) {
+    uint64_t end = now_ns();
+    TraceRing* r = thread_ring();
+    if (r == NULL) return;
+    uint64_t h = atomic_load_explicit(&r->head, memory_order_relaxed);
+    r->events[h & (TRACE_RING_EVENTS - 1)] = (TraceEvent){ z->name, z->start_ns, end - z->start_ns };
+    atomic_store_explicit(&r->head, h + 1, memory_order_release);
+}
+
+static void write_escaped(FILE* f, const char* s) {
+    for (; *s; s++) { if (*s == '"' || *s == '\\') fputc('\\', f); if ((unsigned char)*s >= 0x20) fputc(*s, f); }
+}
+
+// Prstenovi drugih niti se citaju dok one i dalje pisu: pre upisa se kopira
+// prozor, pa se posle ponovnog citanja head-a odbacuju slotovi koje je pisac
+// u medjuvremenu mogao da prepise.
+long trace_dump(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (f == NULL) return -1;
+    TraceEvent* copy = malloc(TRACE_RING_EVENTS * sizeof(TraceEvent));
+    if (copy == NULL) { fclose(f); return -1; }
+    int n = atomic_load(&ring_count);
+    if (n > TRACE_MAX_THREADS) n = TRACE_MAX_THREADS;
+    long written = 0;
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Svemirski Begunac\"}}");
+    for (int t = 0; t < n; t++) {
+        TraceRing* r = &rings[t];
+        if (r->events == NULL) continue;
+        fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"", r->tid);
+        if (r->name != NULL) write_escaped(f, r->name); else fprintf(f, "thread %d", r->tid);
+        fprintf(f, "\"}}");
+        uint64_t h = atomic_load_explicit(&r->head, memory_order_acquire);
+        uint64_t first = h > TRACE_RING_EVENTS ? h - TRACE_RING_EVENTS : 0;
+        for (uint64_t i = first; i < h; i++) copy[i - first] = r->events[i & (TRACE_RING_EVENTS - 1)];
+        // Pisac je stigao do h2 i mozda upravo pise slot h2 (stari dogadjaj h2 - N)
+        uint64_t h2 = atomic_load_explicit(&r->head, memory_order_acquire), base = first;
+        uint64_t safe = h2 >= TRACE_RING_EVENTS ? h2 - TRACE_RING_EVENTS + 1 : 0;
+        if (safe > first) first = safe < h ? safe : h;
+        for (uint64_t i = first; i < h; i++) {
+            const TraceEvent* e = &copy[i - base];
+            fprintf(f, ",\n{\"name\":\"");
+            write_escaped(f, e->name);
+            fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", r->tid, e->start_ns / 1e3, e->dur_ns / 1e3);
+            written++;
+        }
+    }
+    fprintf(f, "\n]}\n");
+    free(copy);
+    if (fclose(f) != 0) return -1;
+    return written;
+}
+
+#else
+typedef int trace_disabled;   // ISO C ne dozvoljava prazan translation unit
+#endif
@@ -0,0 +1,35 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// --- Trace zone (Chrome trace / Perfetto) ---
+// Samo u PROFILE build-u (`make PROFILE=1`); inace se makroi svode na nista.
+// TRACE_ZONE("ime") meri od mesta poziva do kraja opsega (cleanup atribut),
+// pa zona ne moze ostati otvorena ni kod ranog return-a. Svaka nit pise u
+// svoj prsten (jedan pisac, bez zakljucavanja); stari dogadjaji se prepisuju.
+// Ime mora biti string koji zivi do trace_dump (literal).
+#ifdef PROFILE
+
+#include <stdint.h>
+
+typedef struct { const char* name; uint64_t start_ns; } TraceZone;
+
+TraceZone trace_zone_begin(const char* name);
+void trace_zone_end(TraceZone* z);
+// Ime niti u trace-u (inace "thread N")
+void trace_thread_name(const char* name);
+// Upisuje sve prstenove u Chrome trace JSON; vraca broj dogadjaja ili -1
+long trace_dump(const char* path);
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(trace_zone_, __LINE__) __attribute__((cleanup(trace_zone_end))) = trace_zone_begin(name)
+#define TRACE_THREAD(name) trace_thread_name(name)
+
+#else
+
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_THREAD(name) ((void)0)
+
+#endif
+
+#endif
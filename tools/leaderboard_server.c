@@ -0,0 +1,296 @@
+// Zajednicki leaderboard za vise instanci igre na istoj masini. Slusa na Unix
+// socketu (protokol u src/leaderboard_proto.h), rezultate skuplja u grupu i
+// svakih commit_ms ih upisuje u zurnal jednim write + fsync; tek tada salje
+// potvrde. Kompakciju (spajanje snimka sa zurnalom) radi pozadinska nit, pa
+// petlja ne stoji dok se snimak prepisuje. Format fajlova je isti kao kod igre (leaderboard.bin/.journal/.sketch
+// u radnom direktorijumu); server treba pokrenuti u svom direktorijumu, odvojeno
+// od igara koje u njemu cuvaju lokalnu rezervu.
+//
+//   leaderboard_server [-s socket] [-i commit_ms] [-c kompakcija_zapisa]
+//
+// Linux koristi epoll, ostali sistemi poll.
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "leaderboard_proto.h"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+#define MAX_EVENTS 256
+#define CLIENT_OUT_LIMIT (1 << 20)   // klijent koji ne cita odgovore se izbacuje
+#define COMPACT_SECONDS 30
+
+typedef struct {
+    int fd;
+    uint64_t id;
+    unsigned char in[64 * sizeof(LbRequest)];
+    size_t in_len;
+    unsigned char* out;
+    size_t out_len, out_cap;
+    size_t deferred;    // zahtevi ovog klijenta koji cekaju grupni commit
+} Client;
+
+// Zahtev koji ceka grupni commit: SUBMIT, i RANK/TOP iza SUBMIT-a istog
+// klijenta, da odgovori ostanu redom kojim su zahtevi stigli
+typedef struct { int fd; uint64_t id; LbRequest req; } Deferred;
+
+static Client** clients = NULL;   // indeksirano fd-om
+static int clients_cap = 0;
+static uint64_t next_client_id = 1;
+static LeaderboardEntry* batch = NULL;
+static float* batch_survival = NULL;
+static size_t batch_count = 0, batch_cap = 0;
+static Deferred* deferred = NULL;
+static size_t deferred_count = 0, deferred_cap = 0;
+static volatile sig_atomic_t stop = 0;
+
+static double now_ms() { struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return t.tv_sec * 1e3 + t.tv_nsec / 1e6; }
+static void on_signal(int sig) { (void)sig; stop = 1; }
+
+// --- Dogadjaji (epoll / poll) ---
+typedef struct { int fd; int readable, writable; } Event;
+
+#ifdef __linux__
+static int ep = -1;
+static int ev_init() { ep = epoll_create1(0); return ep >= 0; }
+static void ev_set(int fd, int want_write, int op) {
+    struct epoll_event e = { .events = EPOLLIN | (want_write ? EPOLLOUT : 0), .data.fd = fd };
+    epoll_ctl(ep, op, fd, &e);
+}
+static void ev_add(int fd) { ev_set(fd, 0, EPOLL_CTL_ADD); }
+static void ev_want_write(int fd, int on) { ev_set(fd, on, EPOLL_CTL_MOD); }
+static void ev_del(int fd) { epoll_ctl(ep, EPOLL_CTL_DEL, fd, NULL); }
+static int ev_wait(Event* out, int timeout_ms) {
+    struct epoll_event evs[MAX_EVENTS];
+    int n = epoll_wait(ep, evs, MAX_EVENTS, timeout_ms);
+    for (int i = 0; i < n; i++)
+        out[i] = (Event){ evs[i].data.fd, (evs[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0, (evs[i].events & EPOLLOUT) != 0 };
+    return n < 0 ? 0 : n;
+}
+#else
+static struct pollfd* pfds = NULL;
+static int pfd_count = 0, pfd_cap = 0;
+static int ev_init() { return 1; }
+static void ev_add(int fd) {
+    if (pfd_count == pfd_cap) { pfd_cap = pfd_cap ? pfd_cap * 2 : 64; pfds = realloc(pfds, (size_t)pfd_cap * sizeof(struct pollfd)); }
+    pfds[pfd_count++] = (struct pollfd){ .fd = fd, .events = POLLIN };
+}
+static void ev_want_write(int fd, int on) { for (int i = 0; i < pfd_count; i++) if (pfds[i].fd == fd) pfds[i].events = POLLIN | (on ? POLLOUT : 0); }
+static void ev_del(int fd) { for (int i = 0; i < pfd_count; i++) if (pfds[i].fd == fd) { pfds[i] = pfds[--pfd_count]; return; } }
+static int ev_wait(Event* out, int timeout_ms) {
+    if (poll(pfds, (nfds_t)pfd_count, timeout_ms) <= 0) return 0;
+    int n = 0;
+    for (int i = 0; i < pfd_count && n < MAX_EVENTS; i++)
+        if (pfds[i].revents) out[n++] = (Event){ pfds[i].fd, (pfds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0, (pfds[i].revents & POLLOUT) != 0 };
+    return n;
+}
+#endif
+
+// --- Klijenti ---
+static void client_close(Client* c) {
+    ev_del(c->fd);
+    close(c->fd);
+    clients[c->fd] = NULL;
+    free(c->out);
+    free(c);
+}
+
+// Salje koliko moze; vraca 0 ako je veza pukla
+static int client_flush(Client* c) {
+    size_t sent = 0;
+    while (sent < c->out_len) {
+        ssize_t w = send(c->fd, c->out + sent, c->out_len - sent, SEND_FLAGS);
+        if (w < 0) { if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) break; return 0; }
+        sent += (size_t)w;
+    }
+    int had = c->out_len > 0;
+    memmove(c->out, c->out + sent, c->out_len - sent);
+    c->out_len -= sent;
+    if (had) ev_want_write(c->fd, c->out_len > 0);
+    return 1;
+}
+
+static int client_queue(Client* c, const void* data, size_t len) {
+    if (c->out_len + len > CLIENT_OUT_LIMIT) return 0;
+    if (c->out_len + len > c->out_cap) {
+        size_t cap = c->out_cap ? c->out_cap : 4096;
+        while (cap < c->out_len + len) cap *= 2;
+        unsigned char* grown = realloc(c->out, cap); if (grown == NULL) return 0;
+        c->out = grown; c->out_cap = cap;
+    }
+    memcpy(c->out + c->out_len, data, len);
+    c->out_len += len;
+    return 1;
+}
+
+static void batch_push(const LbRequest* r) {
+    if (batch_count == batch_cap) {
+        batch_cap = batch_cap ? batch_cap * 2 : 1024;
+        batch = realloc(batch, batch_cap * sizeof(*batch));
+        batch_survival = realloc(batch_survival, batch_cap * sizeof(*batch_survival));
+    }
+    batch[batch_count] = (LeaderboardEntry){ r->score, r->epoch_time };
+    batch_survival[batch_count++] = r->survival;
+}
+
+static void defer(Client* c, const LbRequest* r) {
+    if (deferred_count == deferred_cap) {
+        deferred_cap = deferred_cap ? deferred_cap * 2 : 1024;
+        deferred = realloc(deferred, deferred_cap * sizeof(*deferred));
+    }
+    deferred[deferred_count++] = (Deferred){ c->fd, c->id, *r };
+    c->deferred++;
+}
+
+// Odgovor na zahtev po trenutnom stanju indeksa; 0 ako klijenta treba izbaciti
+static int reply_to(Client* c, const LbRequest* r) {
+    LbReply reply = { .op = r->op, .total = score_index_total(&score_index) };
+    if (r->op != LB_OP_TOP) { reply.rank = score_index_rank(&score_index, r->score); return client_queue(c, &reply, sizeof(reply)); }
+    reply.count = r->arg < (uint32_t)leaderboard_count ? r->arg : (uint32_t)leaderboard_count;
+    return client_queue(c, &reply, sizeof(reply)) && client_queue(c, leaderboard, reply.count * sizeof(LeaderboardEntry));
+}
+
+// Jedan zahtev; vraca 0 ako klijenta treba izbaciti
+static int handle_request(Client* c, const LbRequest* r) {
+    if (r->op != LB_OP_SUBMIT && r->op != LB_OP_RANK && r->op != LB_OP_TOP) return 0;
+    if (r->op == LB_OP_SUBMIT) batch_push(r);
+    if (r->op == LB_OP_SUBMIT || c->deferred > 0) { defer(c, r); return 1; }
+    return reply_to(c, r);
+}
+
+static void client_read(Client* c) {
+    for (;;) {
+        ssize_t r = recv(c->fd, c->in + c->in_len, sizeof(c->in) - c->in_len, 0);
+        if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) { client_close(c); return; }
+        if (r < 0) break;
+        c->in_len += (size_t)r;
+        size_t used = 0;
+        for (; c->in_len - used >= sizeof(LbRequest); used += sizeof(LbRequest)) {
+            LbRequest req; memcpy(&req, c->in + used, sizeof(req));
+            if (!handle_request(c, &req)) { client_close(c); return; }
+        }
+        memmove(c->in, c->in + used, c->in_len - used);
+        c->in_len -= used;
+    }
+    if (!client_flush(c)) client_close(c);
+}
+
+static void accept_clients(int listen_fd) {
+    int fd;
+    while ((fd = accept(listen_fd, NULL, NULL)) >= 0) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+        int one = 1; setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        if (fd >= clients_cap) {
+            int cap = clients_cap ? clients_cap : 64;
+            while (cap <= fd) cap *= 2;
+            clients = realloc(clients, (size_t)cap * sizeof(Client*));
+            memset(clients + clients_cap, 0, (size_t)(cap - clients_cap) * sizeof(Client*));
+            clients_cap = cap;
+        }
+        Client* c = calloc(1, sizeof(Client));
+        c->fd = fd; c->id = next_client_id++;
+        clients[fd] = c;
+        ev_add(fd);
+    }
+}
+
+// Grupni commit: jedan write + fsync za sve, pa odgovori na odlozene zahteve redom
+static void commit_batch() {
+    if (batch_count == 0) return;
+    leaderboard_commit_batch(batch, batch_survival, batch_count);
+    for (size_t i = 0; i < deferred_count; i++) {
+        Client* c = deferred[i].fd < clients_cap ? clients[deferred[i].fd] : NULL;
+        if (c == NULL || c->id != deferred[i].id) continue;
+        c->deferred--;
+        if (!reply_to(c, &deferred[i].req)) client_close(c);
+    }
+    batch_count = deferred_count = 0;
+    for (int fd = 0; fd < clients_cap; fd++) if (clients[fd] != NULL && !client_flush(clients[fd])) client_close(clients[fd]);
+}
+
+int main(int argc, char** argv) {
+    const char* path = LB_SERVER_SOCKET;
+    int commit_ms = 5;
+    size_t compact_records = 65536;
+    for (int a = 1; a + 1 < argc; a += 2) {
+        if (strcmp(argv[a], "-s") == 0) path = argv[a + 1];
+        else if (strcmp(argv[a], "-i") == 0) commit_ms = atoi(argv[a + 1]);
+        else if (strcmp(argv[a], "-c") == 0) compact_records = (size_t)atol(argv[a + 1]);
+    }
+    if (commit_ms < 1) commit_ms = 1;
+
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    if (strlen(path) >= sizeof(addr.sun_path)) { fprintf(stderr, "Predugacka putanja socketa: %s\n", path); return 1; }
+    strcpy(addr.sun_path, path);
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_fd, 128) != 0) { perror(path); return 1; }
+    fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+    if (!ev_init()) { perror("epoll"); return 1; }
+    ev_add(listen_fd);
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    load_leaderboard();
+    printf("Leaderboard server na %s (%llu igara, commit svakih %d ms)\n", path, (unsigned long long)score_index_total(&score_index), commit_ms);
+    fflush(stdout);
+
+    double batch_start = 0.0;
+    time_t last_compaction = time(NULL);
+    Event events[MAX_EVENTS];
+    while (!stop) {
+        int timeout = 1000;
+        if (batch_count > 0) { timeout = (int)(batch_start + commit_ms - now_ms()); if (timeout < 0) timeout = 0; }
+        int n = ev_wait(events, timeout);
+        size_t before = batch_count;
+        for (int i = 0; i < n; i++) {
+            if (events[i].fd == listen_fd) { accept_clients(listen_fd); continue; }
+            Client* c = events[i].fd < clients_cap ? clients[events[i].fd] : NULL;
+            if (c == NULL) continue;
+            if (events[i].writable && !client_flush(c)) { client_close(c); continue; }
+            if (events[i].readable) client_read(c);
+        }
+        if (before == 0 && batch_count > 0) batch_start = now_ms();
+        if (batch_count > 0 && now_ms() - batch_start >= commit_ms) commit_batch();
+        // Spajanje snimka radi pozadinska nit; petlja samo preuzima rezultat
+        leaderboard_compact_poll(0);
+        size_t pending = leaderboard_journal_pending();
+        if (pending >= compact_records || (pending > 0 && time(NULL) - last_compaction >= COMPACT_SECONDS)) {
+            leaderboard_compact_start();
+            last_compaction = time(NULL);
+        }
+    }
+
+    commit_batch();
+    leaderboard_compact_poll(1);
+    leaderboard_compact();
+    for (int fd = 0; fd < clients_cap; fd++) if (clients[fd] != NULL) client_close(clients[fd]);
+    close(listen_fd);
+    unlink(path);
+    printf("Leaderboard server ugasen (%llu igara)\n", (unsigned long long)score_index_total(&score_index));
+    return 0;
+}
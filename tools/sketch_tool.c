@@ -0,0 +1,34 @@
+// Spaja LEADERBOARD_SKETCH fajlove (sa vise masina ili batch radnika) i
+// ispisuje percentile rezultata i vremena prezivljavanja.
+//
+//   sketch_tool leaderboard.sketch [drugi.sketch ...] [-o spojeni.sketch]
+#include <stdio.h>
+#include <string.h>
+
+#include "leaderboard.h"
+
+static QuantileSketch merged[SKETCH_COUNT], part[SKETCH_COUNT];
+
+static void print_row(const char* name, const QuantileSketch* s, const char* unit) {
+    static const float qs[5] = {0.0f, 0.5f, 0.9f, 0.99f, 1.0f};
+    float out[5];
+    if (!quantile_sketch_query(s, qs, out, 5)) { printf("%-14s nema podataka\n", name); return; }
+    printf("%-14s n=%llu min=%.1f p50=%.1f p90=%.1f p99=%.1f max=%.1f %s\n", name, (unsigned long long)s->n, out[0], out[1], out[2], out[3], out[4], unit);
+}
+
+int main(int argc, char** argv) {
+    const char* out_path = NULL;
+    int inputs = 0;
+    for (int i = 0; i < SKETCH_COUNT; i++) quantile_sketch_init(&merged[i]);
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "-o") == 0 && a + 1 < argc) { out_path = argv[++a]; continue; }
+        if (!quantile_sketch_load(argv[a], part, SKETCH_COUNT)) { fprintf(stderr, "Ne mogu da procitam %s\n", argv[a]); return 1; }
+        for (int i = 0; i < SKETCH_COUNT; i++) quantile_sketch_merge(&merged[i], &part[i]);
+        inputs++;
+    }
+    if (inputs == 0) { fprintf(stderr, "Upotreba: %s fajl.sketch [...] [-o izlaz.sketch]\n", argv[0]); return 1; }
+    print_row("rezultat", &merged[SKETCH_SCORE], "poena");
+    print_row("prezivljavanje", &merged[SKETCH_SURVIVAL], "s");
+    if (out_path != NULL && !quantile_sketch_save(out_path, merged, SKETCH_COUNT)) { fprintf(stderr, "Ne mogu da upisem %s\n", out_path); return 1; }
+    return 0;
+}
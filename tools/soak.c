@@ -0,0 +1,163 @@
+// Dugotrajni test simulacije bez prozora: autopilot (src/bot.h) vodi igru satima simuliranog
+// vremena fiksnim korakom, a na svakih -i sekundi ispisuje ticks/s, percentile
+// trajanja koraka, broj entiteta i najvecu zauzetu memoriju (RSS, frame arena).
+// Korak (ulaz + update_state) i render snapshot se mere odvojeno. Na kraju se
+// proveravaju SLO-ovi; kod izlaza je maska prekrsenih:
+//   2 p99 koraka, 4 ticks/s, 8 RSS, 16 rast p99 koraka (poslednji interval / prvi)
+//
+//   soak [-t sim_sekundi] [-f hz] [-i interval_s] [-n asteroida] [-s seme] [-b nivo_bota] [-r]
+//        [--p99-us X] [--min-tps N] [--max-rss-mb M] [--max-growth F]
+//
+// -n drzi toliko zivih asteroida (do MAX_ASTEROIDS; `make soak_large` ima
+// velike bazene), -r gradi i render snapshot svakog koraka (CPU deo crtanja).
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "arena.h"
+#include "bot.h"
+#include "game.h"
+#include "quantile.h"
+#include "render.h"
+
+enum { SLO_P99 = 2, SLO_TPS = 4, SLO_RSS = 8, SLO_GROWTH = 16 };
+
+static GameState game;
+static Bot bot;
+static QuantileSketch interval_sketch, total_sketch, render_sketch;
+
+static double now_seconds() { struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t); return t.tv_sec + t.tv_nsec / 1e9; }
+
+static double max_rss_mb() {
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return 0.0;
+#ifdef __APPLE__
+    return ru.ru_maxrss / (1024.0 * 1024.0);   // bajtovi
+#else
+    return ru.ru_maxrss / 1024.0;              // KB
+#endif
+}
+
+// Stres: dopuni bazen do n asteroida rasporedjenih po gornjem delu ekrana
+static void top_up_asteroids(GameState* g, int n) {
+    for (int live = bitset_count(g->asteroid_live, ASTEROID_WORDS); live < n; live++) {
+        int i = bitset_first_clear(g->asteroid_live, MAX_ASTEROIDS);
+        if (i < 0) return;
+        spawn_asteroid(g);
+        GameObject* a = &g->asteroids[i];
+        a->position.y = a->prev_position.y = 0.1f + (game_rand(g) % 1000) / 1000.0f;
+    }
+}
+
+int main(int argc, char** argv) {
+    double sim_seconds = 4 * 3600.0, hz = 60.0, interval = 600.0;
+    double slo_p99_us = 0.0, slo_min_tps = 0.0, slo_rss_mb = 0.0, slo_growth = 0.0;
+    int stress = 0, render = 0, skill = BOT_NORMAL;
+    uint32_t seed = 1;
+    for (int a = 1; a < argc; a++) {
+        const char* v = a + 1 < argc ? argv[a + 1] : NULL;
+        if (strcmp(argv[a], "-r") == 0) { render = 1; continue; }
+        if (v == NULL) { fprintf(stderr, "Nedostaje vrednost za %s\n", argv[a]); return 1; }
+        if (strcmp(argv[a], "-t") == 0) sim_seconds = atof(v);
+        else if (strcmp(argv[a], "-f") == 0) hz = atof(v);
+        else if (strcmp(argv[a], "-i") == 0) interval = atof(v);
+        else if (strcmp(argv[a], "-n") == 0) stress = atoi(v);
+        else if (strcmp(argv[a], "-s") == 0) seed = (uint32_t)strtoul(v, NULL, 10);
+        else if (strcmp(argv[a], "-b") == 0) { if ((skill = bot_skill_parse(v)) < 0) { fprintf(stderr, "Nepoznat nivo bota %s\n", v); return 1; } }
+        else if (strcmp(argv[a], "--p99-us") == 0) slo_p99_us = atof(v);
+        else if (strcmp(argv[a], "--min-tps") == 0) slo_min_tps = atof(v);
+        else if (strcmp(argv[a], "--max-rss-mb") == 0) slo_rss_mb = atof(v);
+        else if (strcmp(argv[a], "--max-growth") == 0) slo_growth = atof(v);
+        else { fprintf(stderr, "Nepoznata opcija %s\n", argv[a]); return 1; }
+        a++;
+    }
+    if (hz <= 0.0 || interval <= 0.0) { fprintf(stderr, "Neispravan korak ili interval\n"); return 1; }
+    if (stress > MAX_ASTEROIDS) { fprintf(stderr, "-n %d vece od MAX_ASTEROIDS (%d), koristim %d\n", stress, MAX_ASTEROIDS, MAX_ASTEROIDS); stress = MAX_ASTEROIDS; }
+    if (render && !arena_init(&frame_arena, FRAME_ARENA_SIZE)) { fprintf(stderr, "Nema memorije za frame arenu\n"); return 1; }
+
+    const double dt = 1.0 / hz;
+    const long long total_ticks = (long long)(sim_seconds * hz), interval_ticks = (long long)(interval * hz) > 0 ? (long long)(interval * hz) : 1;
+    printf("Soak: %.0f s simulacije na %.0f Hz (%lld koraka), bazeni a%d-b%d, stres %d, bot %s, render %s\n",
+           sim_seconds, hz, total_ticks, MAX_ASTEROIDS, MAX_BULLETS, stress, bot_skill_name(skill), render ? "da" : "ne");
+    printf("%10s %12s %9s %9s %9s %9s %9s %7s %8s\n", "sim", "ticks/s", "p50 us", "p99 us", "max us", "render99", "entiteta", "igara", "RSS MB");
+
+    initialize_game(&game, seed);
+    game.missed_asteroids_rule_enabled = 1;
+    bot_init(&bot, skill, seed);
+    quantile_sketch_init(&interval_sketch);
+    quantile_sketch_init(&total_sketch);
+    quantile_sketch_init(&render_sketch);
+    const float qs[3] = { 0.5f, 0.99f, 1.0f };
+    float first_p99 = 0.0f, last_p99 = 0.0f, worst_p99 = 0.0f;
+    double min_tps = 0.0, entity_sum = 0.0, wall_start = now_seconds(), interval_start = wall_start;
+    int games = 1, intervals = 0, best_score = 0;
+    double score_sum = 0.0;
+    volatile uint64_t sink = 0;
+
+    for (long long tick = 1; tick <= total_ticks; tick++) {
+        if (stress > 0) top_up_asteroids(&game, stress);
+        GameInput in;
+        bot_think(&bot, &game, dt, &in);
+        double t0 = now_seconds();
+        apply_input(&game, &in, dt);
+        int over = update_state(&game, dt);
+        double t1 = now_seconds();
+        quantile_sketch_add(&interval_sketch, (float)((t1 - t0) * 1e6));
+        if (render) {
+            arena_reset(&frame_arena);
+            RenderSnapshot snapshot;
+            render_snapshot_build(&snapshot, &game, &frame_arena);
+            sink += (uint64_t)snapshot.quads.count;
+            quantile_sketch_add(&render_sketch, (float)((now_seconds() - t1) * 1e6));
+        }
+        entity_sum += bitset_count(game.asteroid_live, ASTEROID_WORDS) + bitset_count(game.bullet_live, BULLET_WORDS);
+        if (over) {
+            if (game.score > best_score) best_score = game.score;
+            score_sum += game.score;
+            initialize_game(&game, seed + (uint32_t)games);
+            game.missed_asteroids_rule_enabled = 1;
+            games++;
+        }
+
+        if (tick % interval_ticks != 0 && tick != total_ticks) continue;
+        double now = now_seconds();
+        long long n = tick % interval_ticks ? tick % interval_ticks : interval_ticks;
+        double tps = n / (now - interval_start);
+        float p[3] = { 0 }, r99 = 0.0f;
+        quantile_sketch_query(&interval_sketch, qs, p, 3);
+        quantile_sketch_query(&render_sketch, &qs[1], &r99, 1);
+        if (intervals == 0) first_p99 = p[1];
+        last_p99 = p[1];
+        if (p[1] > worst_p99) worst_p99 = p[1];
+        if (intervals == 0 || tps < min_tps) min_tps = tps;
+        double sim = tick * dt;
+        printf("%4d:%02d:%02d %12.0f %9.2f %9.2f %9.1f %9.2f %9.0f %7d %8.1f\n", (int)(sim / 3600), (int)(sim / 60) % 60, (int)sim % 60,
+               tps, p[0], p[1], p[2], r99, entity_sum / n, games, max_rss_mb());
+        fflush(stdout);
+        quantile_sketch_merge(&total_sketch, &interval_sketch);
+        quantile_sketch_init(&interval_sketch);
+        quantile_sketch_init(&render_sketch);
+        entity_sum = 0.0;
+        interval_start = now;
+        intervals++;
+    }
+
+    float p[3] = { 0 };
+    quantile_sketch_query(&total_sketch, qs, p, 3);
+    double rss = max_rss_mb(), wall = now_seconds() - wall_start;
+    printf("Ukupno: %lld koraka za %.1f s (%.0f ticks/s) | korak p50 %.2f us, p99 %.2f us, max %.1f us | igara %d | RSS %.1f MB",
+           total_ticks, wall, wall > 0.0 ? total_ticks / wall : 0.0, p[0], p[1], p[2], games, rss);
+    if (render) printf(" | frame arena %zu KB", frame_arena.high_water / 1024);
+    printf("\nRezultati: prosek %.0f, najbolji %d\n", games > 1 ? score_sum / (games - 1) : (double)game.score, best_score > game.score ? best_score : game.score);
+
+    int failed = 0;
+    if (slo_p99_us > 0.0 && worst_p99 > slo_p99_us) { printf("SLO: p99 koraka %.2f us > %.2f us\n", worst_p99, slo_p99_us); failed |= SLO_P99; }
+    if (slo_min_tps > 0.0 && min_tps < slo_min_tps) { printf("SLO: najmanje %.0f ticks/s < %.0f\n", min_tps, slo_min_tps); failed |= SLO_TPS; }
+    if (slo_rss_mb > 0.0 && rss > slo_rss_mb) { printf("SLO: RSS %.1f MB > %.1f MB\n", rss, slo_rss_mb); failed |= SLO_RSS; }
+    if (slo_growth > 0.0 && first_p99 > 0.0f && last_p99 / first_p99 > slo_growth) { printf("SLO: p99 porastao %.2fx (> %.2fx)\n", last_p99 / first_p99, slo_growth); failed |= SLO_GROWTH; }
+    printf(failed ? "SOAK PAO (%d)\n" : "SOAK OK\n", failed);
+    return failed;
+}